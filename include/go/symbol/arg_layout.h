@@ -0,0 +1,59 @@
+#ifndef GO_SYMBOL_ARG_LAYOUT_H
+#define GO_SYMBOL_ARG_LAYOUT_H
+
+#include <go/symbol/symbol.h>
+#include <elf/reader.h>
+
+namespace go::symbol {
+    enum ArgLocation {
+        ARG_STACK,
+        ARG_REGISTER,
+        ARG_UNKNOWN
+    };
+
+    // a scalar argument, or a scalar field or element of an aggregate one. offsets are from the start of
+    // the argument area, which holds the spill slot of a register argument.
+    struct ArgSlot {
+        uint8_t argument;
+        uint8_t offset;
+        uint8_t size;
+        uint8_t location;
+    };
+
+    // the runtime describes at most 10 components, truncated marks arguments or fields left out.
+    struct ArgLayout {
+        std::vector<ArgSlot> slots;
+        bool truncated;
+    };
+
+    class ArgLayoutDecoder {
+    public:
+        ArgLayoutDecoder(
+                std::shared_ptr<const SymbolTable> table,
+                elf::Reader reader,
+                uint64_t funcData,
+                bool registerABI
+        );
+
+    public:
+        [[nodiscard]] std::optional<ArgLayout> layout(size_t index) const;
+        [[nodiscard]] std::vector<std::pair<size_t, ArgLayout>> layouts(
+                std::string_view pattern,
+                size_t concurrency = 1
+        ) const;
+
+    public:
+        [[nodiscard]] const std::shared_ptr<const SymbolTable> &table() const;
+
+    private:
+        void locate(const Symbol &symbol, ArgLayout &layout) const;
+
+    private:
+        bool mRegisterABI;
+        elf::Reader mReader;
+        uint64_t mFuncData;
+        std::shared_ptr<const SymbolTable> mTable;
+    };
+}
+
+#endif //GO_SYMBOL_ARG_LAYOUT_H
@@ -0,0 +1,74 @@
+#ifndef GO_SYMBOL_BATCH_H
+#define GO_SYMBOL_BATCH_H
+
+#include <go/symbol/symbol.h>
+#include <go/symbol/symbolizer.h>
+#include <unordered_map>
+#include <sys/uio.h>
+
+namespace go::symbol {
+    namespace detail {
+        struct ReadRequest {
+            off_t offset;
+            std::vector<iovec> iov;
+        };
+
+        class ReadQueue {
+        public:
+            explicit ReadQueue(unsigned int depth);
+            ReadQueue(const ReadQueue &) = delete;
+            ~ReadQueue();
+
+        public:
+            ReadQueue &operator=(const ReadQueue &) = delete;
+
+        public:
+            bool read(int fd, const std::vector<ReadRequest> &requests);
+
+        private:
+            bool submit(int fd, const std::vector<ReadRequest> &requests, std::vector<bool> &completed);
+
+        private:
+            struct Ring;
+            std::unique_ptr<Ring> mRing;
+        };
+
+        class Prefetched {
+        public:
+            using String = std::string;
+            static constexpr bool CONTIGUOUS = false;
+            static constexpr bool CONCURRENT = false;
+
+        public:
+            explicit Prefetched(const source::File &file);
+
+        public:
+            [[nodiscard]] size_t size() const;
+            bool read(uint64_t offset, void *buffer, size_t length) const;
+
+        public:
+            void want(uint64_t offset, size_t length);
+            bool fetch(ReadQueue &queue);
+
+        private:
+            const source::File &mFile;
+            std::vector<uint64_t> mWanted;
+            std::unordered_map<uint64_t, std::unique_ptr<std::byte[]>> mPages;
+        };
+    }
+
+    class BatchSymbolizer {
+    public:
+        explicit BatchSymbolizer(std::shared_ptr<const BasicSymbolTable<source::File>> table, unsigned int depth = 64);
+
+    public:
+        std::vector<Frame> symbolize(const std::vector<uint64_t> &pcs);
+
+    private:
+        std::mutex mMutex;
+        detail::ReadQueue mQueue;
+        std::shared_ptr<const BasicSymbolTable<source::File>> mTable;
+    };
+}
+
+#endif //GO_SYMBOL_BATCH_H
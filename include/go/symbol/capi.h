@@ -0,0 +1,77 @@
+#ifndef GO_SYMBOL_CAPI_H
+#define GO_SYMBOL_CAPI_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__)
+#define GO_SYMBOL_API __attribute__((visibility("default")))
+#else
+#define GO_SYMBOL_API
+#endif
+
+#define GO_SYMBOL_NONE UINT32_MAX
+#define GO_SYMBOL_NO_OFFSET UINT64_MAX
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct go_symbol go_symbol_t;
+
+enum go_symbol_error {
+    GO_SYMBOL_ERROR_INVALID = -1,
+    GO_SYMBOL_ERROR_NOT_FOUND = -2
+};
+
+/*
+ * caller-owned output arrays of go_symbol_resolve_batch, each holding one element per pc.
+ * a NULL array is skipped along with the decoding it needs, names and files point into the mapped binary
+ * and stay valid until the handle is closed. unknown pcs get entry 0, function GO_SYMBOL_NONE,
+ * NULL strings and line -1.
+ */
+typedef struct {
+    uint64_t *entries;
+    uint32_t *functions;
+    const char **names;
+    const char **files;
+    int32_t *lines;
+} go_symbol_frames_t;
+
+/* base is the load address of a position independent executable and is ignored for others. */
+GO_SYMBOL_API go_symbol_t *go_symbol_open(const char *path, uint64_t base);
+GO_SYMBOL_API void go_symbol_close(go_symbol_t *handle);
+
+GO_SYMBOL_API size_t go_symbol_function_count(const go_symbol_t *handle);
+GO_SYMBOL_API const char *go_symbol_function_name(const go_symbol_t *handle, uint32_t function);
+GO_SYMBOL_API uint64_t go_symbol_function_entry(const go_symbol_t *handle, uint32_t function);
+
+/* thread safe, returns the number of pcs that fall inside a function. */
+GO_SYMBOL_API size_t go_symbol_resolve_batch(
+        const go_symbol_t *handle,
+        const uint64_t *pcs,
+        size_t count,
+        const go_symbol_frames_t *frames
+);
+
+/*
+ * fills offsets[i] with the offset of fields[i] in the named struct, or GO_SYMBOL_NO_OFFSET if it has none.
+ * returns the number of fields found, or a negative go_symbol_error. types are looked up by their type string,
+ * like "http.Request" or "*http.Request", and the first query of a type caches its layout.
+ */
+GO_SYMBOL_API int go_symbol_type_field_offsets(
+        go_symbol_t *handle,
+        const char *type,
+        const char *const *fields,
+        size_t count,
+        uint64_t *offsets
+);
+
+/* copies the build id into buffer like snprintf and returns its full length, or a negative go_symbol_error. */
+GO_SYMBOL_API int go_symbol_build_id(const go_symbol_t *handle, char *buffer, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //GO_SYMBOL_CAPI_H
@@ -0,0 +1,35 @@
+#ifndef GO_SYMBOL_DIFF_H
+#define GO_SYMBOL_DIFF_H
+
+#include <go/symbol/reader.h>
+
+namespace go::symbol {
+    enum ChangeKind {
+        FUNCTION_ADDED,
+        FUNCTION_REMOVED,
+        FUNCTION_RESIZED,
+        FUNCTION_MODIFIED
+    };
+
+    enum DiffOption {
+        DiffSizes = 0,
+        DiffContents = 1
+    };
+
+    struct FunctionChange {
+        ChangeKind kind;
+        std::string name;
+        uint64_t before;
+        uint64_t after;
+    };
+
+    struct BinaryDiff {
+        std::vector<FunctionChange> changes;
+        size_t unchanged;
+    };
+
+    std::optional<BinaryDiff> diff(Reader &before, Reader &after, int options = DiffSizes, size_t concurrency = 1);
+    std::string toJSON(const BinaryDiff &diff);
+}
+
+#endif //GO_SYMBOL_DIFF_H
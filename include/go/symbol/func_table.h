@@ -0,0 +1,76 @@
+#ifndef GO_SYMBOL_FUNC_TABLE_H
+#define GO_SYMBOL_FUNC_TABLE_H
+
+#include <go/symbol/symbol.h>
+#include <vector>
+
+namespace go::symbol {
+    class CompactFuncIterator;
+
+    // replaces the functab of a table: entries are read once from source, and lookups resolve _func records
+    // through table, whose copy of the section may leave the functab out. a source that is empty, or whose
+    // text or functab does not fit 32-bit offsets, leaves the table empty.
+    class CompactFuncTable {
+    public:
+        CompactFuncTable(const SymbolTable &source, std::shared_ptr<const SymbolTable> table);
+
+    public:
+        static std::vector<std::pair<uint64_t, uint64_t>> regions(const SymbolTable &table, int queries);
+
+    public:
+        [[nodiscard]] CompactFuncIterator find(uint64_t address) const;
+
+    public:
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] size_t memoryUsage() const;
+
+    public:
+        [[nodiscard]] SymbolEntry operator[](size_t index) const;
+
+    public:
+        [[nodiscard]] CompactFuncIterator begin() const;
+        [[nodiscard]] CompactFuncIterator end() const;
+
+    private:
+        uint64_t mBase{};
+        std::shared_ptr<const SymbolTable> mTable;
+
+    private:
+        std::vector<uint32_t> mEntries;
+        std::vector<uint32_t> mOffsets;
+        std::vector<uint32_t> mSkipIndex;
+    };
+
+    class CompactFuncIterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = SymbolEntry;
+        using pointer = value_type *;
+        using reference = value_type &;
+        using iterator_category = std::random_access_iterator_tag;
+
+    public:
+        CompactFuncIterator(const CompactFuncTable *table, size_t index);
+
+    public:
+        SymbolEntry operator*();
+        CompactFuncIterator &operator--();
+        CompactFuncIterator &operator++();
+        CompactFuncIterator &operator+=(std::ptrdiff_t offset);
+        CompactFuncIterator operator-(std::ptrdiff_t offset);
+        CompactFuncIterator operator+(std::ptrdiff_t offset);
+
+    public:
+        bool operator==(const CompactFuncIterator &rhs);
+        bool operator!=(const CompactFuncIterator &rhs);
+
+    public:
+        std::ptrdiff_t operator-(const CompactFuncIterator &rhs);
+
+    private:
+        size_t mIndex;
+        const CompactFuncTable *mTable;
+    };
+}
+
+#endif //GO_SYMBOL_FUNC_TABLE_H
@@ -0,0 +1,31 @@
+#ifndef GO_SYMBOL_FUNCTION_MAP_H
+#define GO_SYMBOL_FUNCTION_MAP_H
+
+#include <go/symbol/symbol.h>
+
+namespace go::symbol {
+    constexpr auto NO_FUNCTION = UINT32_MAX;
+    constexpr auto DEFAULT_FUNCTION_MAP_CAPACITY = 1 << 20;
+    constexpr auto DEFAULT_SEARCH_DEPTH = 8;
+
+    // offsets are sorted text offsets from base, each paired with the functab index at the same position,
+    // and a trailing NO_FUNCTION entry marks the end of text. a pc at offset x is owned by the last entry
+    // not above x, which always lies within [buckets[x >> shift], buckets[(x >> shift) + 1]], so at most
+    // depth halvings of that window find it.
+    struct FunctionMap {
+        uint64_t base;
+        uint32_t shift;
+        int depth;
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> functions;
+        std::vector<uint32_t> buckets;
+    };
+
+    std::optional<FunctionMap> exportFunctionMap(
+            const SymbolTable &table,
+            size_t capacity = DEFAULT_FUNCTION_MAP_CAPACITY,
+            int depth = DEFAULT_SEARCH_DEPTH
+    );
+}
+
+#endif //GO_SYMBOL_FUNCTION_MAP_H
@@ -0,0 +1,31 @@
+#ifndef GO_SYMBOL_INLINE_H
+#define GO_SYMBOL_INLINE_H
+
+#include <go/symbol/symbol.h>
+#include <go/symbol/symbolizer.h>
+#include <elf/reader.h>
+
+namespace go::symbol {
+    class InlineUnwinder {
+    public:
+        InlineUnwinder(
+                std::shared_ptr<const SymbolTable> table,
+                elf::Reader reader,
+                endian::Converter converter,
+                uint64_t funcData
+        );
+
+    public:
+        // frames of a pc from the innermost inlined call out to the physical function.
+        [[nodiscard]] std::vector<Frame> frames(uint64_t pc) const;
+        [[nodiscard]] const std::shared_ptr<const SymbolTable> &table() const;
+
+    private:
+        elf::Reader mReader;
+        uint64_t mFuncData;
+        endian::Converter mConverter;
+        std::shared_ptr<const SymbolTable> mTable;
+    };
+}
+
+#endif //GO_SYMBOL_INLINE_H
@@ -0,0 +1,285 @@
+#ifndef GO_SYMBOL_LINE_INDEX_H
+#define GO_SYMBOL_LINE_INDEX_H
+
+#include <go/symbol/symbol.h>
+#include <istream>
+#include <ostream>
+#include <mutex>
+#include <vector>
+
+namespace go::symbol {
+    struct LineRange {
+        uint64_t begin;
+        uint64_t end;
+        uint32_t file;
+        int32_t line;
+        uint32_t index;
+    };
+
+    template<typename Source>
+    class BasicLineIndex {
+    public:
+        explicit BasicLineIndex(const BasicSymbolTable<Source> *table, size_t concurrency = 1);
+
+    public:
+        [[nodiscard]] std::vector<LineRange> find(uint32_t file, int line) const;
+        [[nodiscard]] std::vector<LineRange> find(std::string_view file, int line) const;
+
+    public:
+        [[nodiscard]] size_t size() const;
+
+    public:
+        bool save(std::ostream &stream) const;
+        bool load(std::istream &stream);
+
+    private:
+        void build() const;
+        void collect(size_t begin, size_t end, std::vector<LineRange> &ranges) const;
+
+    private:
+        size_t mConcurrency;
+        const BasicSymbolTable<Source> *mTable;
+        std::unique_ptr<std::once_flag> mBuilt;
+        mutable std::vector<LineRange> mRanges;
+        mutable std::unordered_map<std::string_view, uint32_t> mFiles;
+    };
+
+    using LineIndex = BasicLineIndex<source::Memory>;
+}
+
+namespace go::symbol::detail {
+    constexpr auto LINE_INDEX_MAGIC = 0x78646e696c6f67;
+    constexpr auto LINE_INDEX_VERSION = 2;
+
+    // every field is written on its own in host byte order, a saved range takes 28 bytes.
+    constexpr auto LINE_RANGE_RECORD_SIZE = 8 + 8 + 4 + 4 + 4;
+
+    template<typename T>
+    void put(std::ostream &stream, T value) {
+        stream.write((const char *) &value, sizeof(T));
+    }
+
+    template<typename T>
+    bool get(std::istream &stream, T &value) {
+        return bool(stream.read((char *) &value, sizeof(T)));
+    }
+}
+
+template<typename Source>
+go::symbol::BasicLineIndex<Source>::BasicLineIndex(const BasicSymbolTable<Source> *table, size_t concurrency)
+        : mConcurrency(concurrency), mTable(table), mBuilt(std::make_unique<std::once_flag>()) {
+
+}
+
+template<typename Source>
+std::vector<go::symbol::LineRange> go::symbol::BasicLineIndex<Source>::find(uint32_t file, int line) const {
+    build();
+
+    auto [first, last] = std::equal_range(
+            mRanges.begin(),
+            mRanges.end(),
+            LineRange{0, 0, file, line, 0},
+            [](const auto &lhs, const auto &rhs) {
+                return std::tie(lhs.file, lhs.line) < std::tie(rhs.file, rhs.line);
+            }
+    );
+
+    return {first, last};
+}
+
+template<typename Source>
+std::vector<go::symbol::LineRange> go::symbol::BasicLineIndex<Source>::find(std::string_view file, int line) const {
+    build();
+
+    auto it = mFiles.find(file);
+
+    if (it == mFiles.end())
+        return {};
+
+    return find(it->second, line);
+}
+
+template<typename Source>
+size_t go::symbol::BasicLineIndex<Source>::size() const {
+    build();
+    return mRanges.size();
+}
+
+template<typename Source>
+bool go::symbol::BasicLineIndex<Source>::save(std::ostream &stream) const {
+    build();
+
+    // pcs are saved relative to the first function, so the index of a pie fits the binary at any load base.
+    // the function count and text span tie it to the table it was built from.
+    size_t size = mTable->size();
+    uint64_t text = size ? (*mTable)[0].entry() : 0;
+
+    detail::put<uint64_t>(stream, detail::LINE_INDEX_MAGIC);
+    detail::put<uint32_t>(stream, detail::LINE_INDEX_VERSION);
+    detail::put<uint32_t>(stream, size);
+    detail::put<uint64_t>(stream, size ? (*mTable)[size].entry() - text : 0);
+    detail::put<uint64_t>(stream, mRanges.size());
+
+    for (const auto &range: mRanges) {
+        detail::put<uint64_t>(stream, range.begin - text);
+        detail::put<uint64_t>(stream, range.end - text);
+        detail::put<uint32_t>(stream, range.file);
+        detail::put<int32_t>(stream, range.line);
+        detail::put<uint32_t>(stream, range.index);
+    }
+
+    return stream.good();
+}
+
+template<typename Source>
+bool go::symbol::BasicLineIndex<Source>::load(std::istream &stream) {
+    uint64_t magic, span, count;
+    uint32_t version, functions;
+
+    if (!detail::get(stream, magic) || !detail::get(stream, version) || !detail::get(stream, functions) ||
+        !detail::get(stream, span) || !detail::get(stream, count))
+        return false;
+
+    if (magic != detail::LINE_INDEX_MAGIC || version != detail::LINE_INDEX_VERSION)
+        return false;
+
+    size_t size = mTable->size();
+    uint64_t text = size ? (*mTable)[0].entry() : 0;
+
+    if (functions != size || span != (size ? (*mTable)[size].entry() - text : 0))
+        return false;
+
+    // a count the rest of the stream cannot hold is corrupt, refuse it before allocating anything.
+    std::istream::pos_type position = stream.tellg();
+
+    if (position != std::istream::pos_type(-1) && stream.seekg(0, std::ios::end)) {
+        auto remaining = uint64_t(stream.tellg() - position);
+        stream.seekg(position);
+
+        if (count > remaining / detail::LINE_RANGE_RECORD_SIZE)
+            return false;
+    }
+
+    stream.clear();
+
+    // file ids come straight from the stream, so each must name a terminated entry of the file table.
+    uint64_t files = mTable->mVersion == VERSION12 ? mTable->mSource.size() : mTable->mPCTable;
+    std::vector<LineRange> ranges;
+
+    for (uint64_t i = 0; i < count; i++) {
+        LineRange range = {};
+
+        if (!detail::get(stream, range.begin) || !detail::get(stream, range.end) || !detail::get(stream, range.file) ||
+            !detail::get(stream, range.line) || !detail::get(stream, range.index))
+            return false;
+
+        if (range.begin >= range.end || range.end > span || range.index >= size ||
+            !mTable->terminated(mTable->fileOffset(range.file), files))
+            return false;
+
+        range.begin += text;
+        range.end += text;
+
+        ranges.push_back(range);
+    }
+
+    bool loaded = false;
+
+    std::call_once(*mBuilt, [&]() {
+        mRanges = std::move(ranges);
+
+        for (const auto &range: mRanges)
+            mFiles.emplace(mTable->fileName(range.file), range.file);
+
+        loaded = true;
+    });
+
+    return loaded;
+}
+
+template<typename Source>
+void go::symbol::BasicLineIndex<Source>::build() const {
+    std::call_once(*mBuilt, [this]() {
+        size_t size = mTable->size();
+        size_t concurrency = mConcurrency;
+
+        if constexpr (!Source::CONCURRENT)
+            concurrency = 1;
+
+        concurrency = std::max<size_t>(1, std::min<size_t>(concurrency, size / detail::MIN_PARALLEL_FUNCTIONS));
+
+        size_t step = (size + concurrency - 1) / concurrency;
+
+        std::vector<std::vector<LineRange>> parts(concurrency);
+        std::vector<std::thread> threads;
+
+        for (size_t i = 1; i < concurrency; i++) {
+            threads.emplace_back([=, &parts]() {
+                collect(i * step, std::min(size, (i + 1) * step), parts[i]);
+            });
+        }
+
+        collect(0, std::min(size, step), parts[0]);
+
+        for (auto &thread: threads)
+            thread.join();
+
+        for (auto &part: parts)
+            mRanges.insert(mRanges.end(), part.begin(), part.end());
+
+        std::sort(mRanges.begin(), mRanges.end(), [](const auto &lhs, const auto &rhs) {
+            return std::tie(lhs.file, lhs.line, lhs.begin) < std::tie(rhs.file, rhs.line, rhs.begin);
+        });
+
+        for (const auto &range: mRanges)
+            mFiles.emplace(mTable->fileName(range.file), range.file);
+    });
+}
+
+template<typename Source>
+void go::symbol::BasicLineIndex<Source>::collect(size_t begin, size_t end, std::vector<LineRange> &ranges) const {
+    std::vector<std::pair<uint64_t, int>> files;
+
+    for (size_t i = begin; i < end; i++) {
+        BasicSymbol<Source> symbol = (*mTable)[i].symbol();
+        uint64_t entry = symbol.entry();
+
+        files.clear();
+
+        // pcfile changes far less often than pcln, so its runs are gathered first and walked alongside the lines.
+        mTable->runs(symbol.field(5), entry, [&](uint64_t, uint64_t stop, int value) {
+            files.emplace_back(stop, value);
+            return true;
+        });
+
+        uint32_t cu = mTable->mVersion == VERSION12 ? 0 : symbol.field(8);
+        auto it = files.begin();
+
+        mTable->runs(symbol.field(6), entry, [&](uint64_t start, uint64_t stop, int line) {
+            while (start < stop) {
+                while (it != files.end() && it->first <= start)
+                    ++it;
+
+                if (it == files.end())
+                    return false;
+
+                uint64_t split = std::min(stop, it->first);
+                std::optional<uint32_t> file = mTable->fileID(cu, it->second);
+
+                if (file && line >= 0) {
+                    if (!ranges.empty() && ranges.back().end == start && ranges.back().file == *file &&
+                        ranges.back().line == line && ranges.back().index == i)
+                        ranges.back().end = split;
+                    else
+                        ranges.push_back({start, split, *file, line, (uint32_t) i});
+                }
+
+                start = split;
+            }
+
+            return true;
+        });
+    }
+}
+
+#endif //GO_SYMBOL_LINE_INDEX_H
@@ -0,0 +1,41 @@
+#ifndef GO_SYMBOL_MIXED_H
+#define GO_SYMBOL_MIXED_H
+
+#include <go/symbol/symbol.h>
+#include <go/symbol/symbolizer.h>
+
+namespace go::symbol {
+    struct NativeSymbol {
+        uint64_t address;
+        uint64_t size;
+        std::string name;
+    };
+
+    class MixedSymbolizer {
+    public:
+        MixedSymbolizer(std::shared_ptr<const SymbolTable> table, std::vector<NativeSymbol> symbols);
+
+    public:
+        [[nodiscard]] Frame symbolize(uint64_t pc) const;
+        [[nodiscard]] std::vector<Frame> symbolize(const std::vector<uint64_t> &pcs) const;
+
+    public:
+        [[nodiscard]] size_t size() const;
+
+    private:
+        struct Interval {
+            uint64_t begin;
+            uint64_t end;
+            uint32_t index;
+            bool native;
+        };
+
+    private:
+        std::string mNames;
+        std::vector<Interval> mIntervals;
+        std::vector<uint32_t> mNameOffsets;
+        std::shared_ptr<const SymbolTable> mTable;
+    };
+}
+
+#endif //GO_SYMBOL_MIXED_H
@@ -19,6 +19,7 @@ namespace go::symbol {
         [[nodiscard]] std::optional<uint64_t> pcHeader() const;
         [[nodiscard]] std::optional<uint64_t> types() const;
         [[nodiscard]] std::optional<uint64_t> etypes() const;
+        [[nodiscard]] std::optional<uint64_t> gofunc() const;
         [[nodiscard]] std::optional<std::pair<const std::byte*, uint64_t>> typeLinks() const;
         [[nodiscard]] std::optional<std::pair<const std::byte*, uint64_t>> itabLinks() const;
         // 返回 {types, etypes}
@@ -0,0 +1,175 @@
+#ifndef GO_SYMBOL_MODULE_INDEX_H
+#define GO_SYMBOL_MODULE_INDEX_H
+
+#include <go/symbol/symbol.h>
+#include <go/symbol/build_info.h>
+#include <unordered_map>
+#include <thread>
+#include <vector>
+
+namespace go::symbol {
+    namespace detail {
+        std::string_view packagePath(std::string_view name);
+        std::string symbolPrefix(std::string_view path);
+    }
+
+    constexpr auto NO_MODULE = UINT32_MAX;
+
+    template<typename Source>
+    class BasicModuleIndex {
+    public:
+        BasicModuleIndex(const BasicSymbolTable<Source> *table, const ModuleInfo &info, size_t concurrency = 1);
+        BasicModuleIndex(const BasicModuleIndex &) = delete;
+        BasicModuleIndex(BasicModuleIndex &&) = default;
+
+    public:
+        BasicModuleIndex &operator=(const BasicModuleIndex &) = delete;
+        BasicModuleIndex &operator=(BasicModuleIndex &&) = default;
+
+    public:
+        [[nodiscard]] uint32_t module(size_t index) const;
+        [[nodiscard]] const std::vector<uint32_t> &modules() const;
+        [[nodiscard]] const std::vector<std::string> &paths() const;
+
+    public:
+        [[nodiscard]] std::vector<size_t> attribute(const std::vector<uint64_t> &pcs) const;
+
+    private:
+        void collect(size_t begin, size_t end);
+        [[nodiscard]] uint32_t match(std::string_view package) const;
+
+    private:
+        const BasicSymbolTable<Source> *mTable;
+        std::vector<uint32_t> mModules;
+        std::vector<std::string> mPaths;
+        std::vector<std::string> mPrefixes;
+
+        // keys view the strings in mPaths and mPrefixes, which a move hands over intact but a copy would leave behind.
+        std::unordered_map<std::string_view, uint32_t> mIndices;
+    };
+
+    using ModuleIndex = BasicModuleIndex<source::Memory>;
+}
+
+template<typename Source>
+go::symbol::BasicModuleIndex<Source>::BasicModuleIndex(
+        const BasicSymbolTable<Source> *table,
+        const ModuleInfo &info,
+        size_t concurrency
+) : mTable(table) {
+    mPaths.push_back(info.main.path);
+
+    for (const auto &dep: info.deps)
+        mPaths.push_back(dep.path);
+
+    mPrefixes.reserve(mPaths.size());
+
+    // symbols escape dots in the last element of their package path, so a package that is the module root
+    // matches the escaped form, while deeper packages truncated at a '/' match the plain one.
+    for (size_t i = 0; i < mPaths.size(); i++) {
+        mPrefixes.push_back(detail::symbolPrefix(mPaths[i]));
+
+        mIndices.emplace(mPaths[i], (uint32_t) i);
+        mIndices.emplace(mPrefixes[i], (uint32_t) i);
+    }
+
+    // the main package is named "main" in symbols, not after the main module.
+    mIndices.emplace("main", 0);
+
+    size_t size = mTable->size();
+    mModules.resize(size, NO_MODULE);
+
+    if constexpr (!Source::CONCURRENT)
+        concurrency = 1;
+
+    concurrency = std::max<size_t>(1, std::min<size_t>(concurrency, size / detail::MIN_PARALLEL_FUNCTIONS));
+
+    size_t step = (size + concurrency - 1) / concurrency;
+    std::vector<std::thread> threads;
+
+    for (size_t i = 1; i < concurrency; i++) {
+        threads.emplace_back([=]() {
+            collect(i * step, std::min(size, (i + 1) * step));
+        });
+    }
+
+    collect(0, std::min(size, step));
+
+    for (auto &thread: threads)
+        thread.join();
+}
+
+template<typename Source>
+uint32_t go::symbol::BasicModuleIndex<Source>::module(size_t index) const {
+    return mModules[index];
+}
+
+template<typename Source>
+const std::vector<uint32_t> &go::symbol::BasicModuleIndex<Source>::modules() const {
+    return mModules;
+}
+
+template<typename Source>
+const std::vector<std::string> &go::symbol::BasicModuleIndex<Source>::paths() const {
+    return mPaths;
+}
+
+template<typename Source>
+std::vector<size_t> go::symbol::BasicModuleIndex<Source>::attribute(const std::vector<uint64_t> &pcs) const {
+    // one count per module, the trailing one gathers the standard library, runtime assembly and unknown pcs.
+    std::vector<size_t> counts(mPaths.size() + 1);
+
+    for (const auto &pc: pcs) {
+        auto it = mTable->find(pc);
+
+        if (it == mTable->end()) {
+            counts.back()++;
+            continue;
+        }
+
+        uint32_t module = mModules[(*it).index()];
+        counts[module == NO_MODULE ? mPaths.size() : module]++;
+    }
+
+    return counts;
+}
+
+template<typename Source>
+void go::symbol::BasicModuleIndex<Source>::collect(size_t begin, size_t end) {
+    std::string_view last;
+    uint32_t module = NO_MODULE;
+
+    // functab order keeps the functions of a package together, so a match is mostly reused.
+    for (size_t i = begin; i < end; i++) {
+        std::string_view package = detail::packagePath(mTable->functionName(i));
+
+        if (package != last) {
+            last = package;
+            module = match(package);
+        }
+
+        mModules[i] = module;
+    }
+}
+
+template<typename Source>
+uint32_t go::symbol::BasicModuleIndex<Source>::match(std::string_view package) const {
+    // the longest module path owning the package wins, trying each '/' boundary from the full path down.
+    while (!package.empty()) {
+        auto it = mIndices.find(package);
+
+        if (it != mIndices.end())
+            return it->second;
+
+        size_t n = package.rfind('/');
+
+        if (n == std::string_view::npos)
+            break;
+
+        package = package.substr(0, n);
+    }
+
+    return NO_MODULE;
+}
+
+#endif //GO_SYMBOL_MODULE_INDEX_H
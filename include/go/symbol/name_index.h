@@ -0,0 +1,262 @@
+#ifndef GO_SYMBOL_NAME_INDEX_H
+#define GO_SYMBOL_NAME_INDEX_H
+
+#include <go/symbol/symbol.h>
+#include <mutex>
+#include <vector>
+
+namespace go::symbol {
+    namespace detail {
+        size_t search(const char *buffer, size_t size, size_t from, std::string_view needle);
+        bool glob(std::string_view pattern, std::string_view name);
+    }
+
+    template<typename Source>
+    class BasicNameIndex {
+    public:
+        explicit BasicNameIndex(const BasicSymbolTable<Source> *table);
+
+    public:
+        [[nodiscard]] std::vector<size_t> prefix(std::string_view prefix) const;
+        [[nodiscard]] std::vector<size_t> package(std::string_view package) const;
+        [[nodiscard]] std::vector<size_t> receiver(std::string_view package, std::string_view type) const;
+
+    public:
+        [[nodiscard]] std::vector<size_t> search(std::string_view substring) const;
+        [[nodiscard]] std::vector<size_t> glob(std::string_view pattern) const;
+
+    public:
+        [[nodiscard]] std::pair<uint64_t, uint64_t> range(size_t index) const;
+
+    private:
+        void build() const;
+        void collect(std::string_view prefix, std::vector<size_t> &indices) const;
+
+    private:
+        void load() const;
+
+        template<typename F>
+        void scan(std::string_view literal, F &&accept, std::vector<size_t> &indices) const;
+
+    private:
+        const BasicSymbolTable<Source> *mTable;
+        std::unique_ptr<std::once_flag> mBuilt;
+        std::unique_ptr<std::once_flag> mLoaded;
+        mutable std::vector<std::pair<std::string_view, uint32_t>> mNames;
+
+    private:
+        mutable size_t mBlobSize{};
+        mutable const char *mBlob{};
+        mutable std::unique_ptr<char[]> mBlobBuffer;
+        mutable std::vector<std::pair<uint32_t, uint32_t>> mOffsets;
+    };
+
+    using NameIndex = BasicNameIndex<source::Memory>;
+}
+
+template<typename Source>
+go::symbol::BasicNameIndex<Source>::BasicNameIndex(const BasicSymbolTable<Source> *table)
+        : mTable(table), mBuilt(std::make_unique<std::once_flag>()), mLoaded(std::make_unique<std::once_flag>()) {
+
+}
+
+template<typename Source>
+std::vector<size_t> go::symbol::BasicNameIndex<Source>::prefix(std::string_view prefix) const {
+    std::vector<size_t> indices;
+    collect(prefix, indices);
+
+    return indices;
+}
+
+template<typename Source>
+std::vector<size_t> go::symbol::BasicNameIndex<Source>::package(std::string_view package) const {
+    // a nested package continues with '/', so the dot keeps "net/http" from matching "net/http/httputil".
+    return prefix(std::string(package) + ".");
+}
+
+template<typename Source>
+std::vector<size_t> go::symbol::BasicNameIndex<Source>::receiver(std::string_view package, std::string_view type) const {
+    std::string base = std::string(package) + ".";
+    std::vector<size_t> indices;
+
+    // pointer and value receivers, each either plain or instantiated with type arguments.
+    collect(base + "(*" + std::string(type) + ").", indices);
+    collect(base + "(*" + std::string(type) + "[", indices);
+    collect(base + std::string(type) + ".", indices);
+    collect(base + std::string(type) + "[", indices);
+
+    return indices;
+}
+
+template<typename Source>
+std::vector<size_t> go::symbol::BasicNameIndex<Source>::search(std::string_view substring) const {
+    std::vector<size_t> indices;
+
+    scan(substring, [](std::string_view) {
+        return true;
+    }, indices);
+
+    return indices;
+}
+
+template<typename Source>
+std::vector<size_t> go::symbol::BasicNameIndex<Source>::glob(std::string_view pattern) const {
+    std::string_view literal;
+    std::string_view remain = pattern;
+
+    // the longest run without wildcards filters candidates through the block scan before the full match.
+    while (!remain.empty()) {
+        size_t n = remain.find_first_of("*?");
+        std::string_view segment = remain.substr(0, n);
+
+        if (segment.size() > literal.size())
+            literal = segment;
+
+        if (n == std::string_view::npos)
+            break;
+
+        remain.remove_prefix(n + 1);
+    }
+
+    std::vector<size_t> indices;
+
+    scan(literal, [=](std::string_view name) {
+        return detail::glob(pattern, name);
+    }, indices);
+
+    return indices;
+}
+
+template<typename Source>
+std::pair<uint64_t, uint64_t> go::symbol::BasicNameIndex<Source>::range(size_t index) const {
+    // the functab carries one trailing entry, the end of the last function.
+    return {(*mTable)[index].entry(), (*mTable)[index + 1].entry()};
+}
+
+template<typename Source>
+void go::symbol::BasicNameIndex<Source>::build() const {
+    std::call_once(*mBuilt, [this]() {
+        size_t size = mTable->size();
+        mNames.reserve(size);
+
+        for (size_t i = 0; i < size; i++)
+            mNames.emplace_back(mTable->functionName(i), (uint32_t) i);
+
+        std::sort(mNames.begin(), mNames.end());
+    });
+}
+
+template<typename Source>
+void go::symbol::BasicNameIndex<Source>::collect(std::string_view prefix, std::vector<size_t> &indices) const {
+    build();
+
+    auto first = std::lower_bound(
+            mNames.begin(),
+            mNames.end(),
+            prefix,
+            [](const auto &name, std::string_view value) {
+                return name.first < value;
+            }
+    );
+
+    for (auto it = first; it != mNames.end() && it->first.substr(0, prefix.size()) == prefix; ++it)
+        indices.push_back(it->second);
+}
+
+template<typename Source>
+void go::symbol::BasicNameIndex<Source>::load() const {
+    std::call_once(*mLoaded, [this]() {
+        const BasicSymbolTable<Source> *table = mTable;
+
+        // before go 1.16 names are scattered over the whole section, so there is no block to scan.
+        if (table->mVersion == VERSION12 || table->mCuTable < table->mFuncNameTable)
+            return;
+
+        mBlobSize = table->mCuTable - table->mFuncNameTable;
+
+        if constexpr (Source::CONTIGUOUS) {
+            mBlob = (const char *) table->mSource.data() + table->mFuncNameTable;
+        } else {
+            mBlobBuffer = std::make_unique<char[]>(mBlobSize + 1);
+
+            if (!table->mSource.read(table->mFuncNameTable, mBlobBuffer.get(), mBlobSize)) {
+                mBlobBuffer.reset();
+                mBlobSize = 0;
+                return;
+            }
+
+            mBlob = mBlobBuffer.get();
+        }
+
+        mOffsets.reserve(table->size());
+
+        for (size_t i = 0; i < table->size(); i++) {
+            BasicSymbol<Source> symbol = (*table)[i].symbol();
+            mOffsets.emplace_back(symbol.field(1), (uint32_t) i);
+        }
+
+        std::sort(mOffsets.begin(), mOffsets.end());
+    });
+}
+
+template<typename Source>
+template<typename F>
+void go::symbol::BasicNameIndex<Source>::scan(std::string_view literal, F &&accept, std::vector<size_t> &indices) const {
+    load();
+
+    if (!mBlob) {
+        for (size_t i = 0; i < mTable->size(); i++) {
+            std::string_view name = mTable->functionName(i);
+
+            if (name.find(literal) != std::string_view::npos && accept(name))
+                indices.push_back(i);
+        }
+
+        return;
+    }
+
+    auto name = [this](uint32_t offset) {
+        return std::string_view(mBlob + offset, strnlen(mBlob + offset, mBlobSize - offset));
+    };
+
+    if (literal.empty()) {
+        for (const auto &[offset, index]: mOffsets) {
+            if (offset < mBlobSize && accept(name(offset)))
+                indices.push_back(index);
+        }
+
+        return;
+    }
+
+    size_t position = 0;
+
+    while ((position = detail::search(mBlob, mBlobSize, position, literal)) != std::string::npos) {
+        // the block also holds names of functions that only exist inlined, which have no functab entry.
+        auto it = std::upper_bound(
+                mOffsets.begin(),
+                mOffsets.end(),
+                std::make_pair((uint32_t) position, UINT32_MAX)
+        );
+
+        auto terminator = (const char *) memchr(mBlob + position, 0, mBlobSize - position);
+        size_t end = terminator ? terminator - mBlob : mBlobSize;
+
+        if (it != mOffsets.begin()) {
+            uint32_t offset = std::prev(it)->first;
+            std::string_view str = name(offset);
+
+            if (offset + str.size() == end && accept(str)) {
+                for (auto i = std::prev(it); i->first == offset; --i) {
+                    indices.push_back(i->second);
+
+                    if (i == mOffsets.begin())
+                        break;
+                }
+            }
+        }
+
+        position = end + 1;
+    }
+}
+
+#endif //GO_SYMBOL_NAME_INDEX_H
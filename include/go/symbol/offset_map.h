@@ -15,6 +15,7 @@ namespace go {
             uint64_t typelinks_len;
             uint64_t itablinks_ptr;
             uint64_t itablinks_len;
+            uint64_t gofunc;
         };
 
         inline std::optional<Offsets> getOffsets(const go::Version& version, size_t ptrSize) {
@@ -25,7 +26,8 @@ namespace go {
                         .typelinks_ptr = 44 * ptrSize,
                         .typelinks_len = 45 * ptrSize,
                         .itablinks_ptr = 47 * ptrSize,
-                        .itablinks_len = 48 * ptrSize
+                        .itablinks_len = 48 * ptrSize,
+                        .gofunc = 40 * ptrSize
                 };
             } else if (version >= go::Version{1, 18}) {
                 return Offsets{
@@ -34,7 +36,8 @@ namespace go {
                         .typelinks_ptr = 42 * ptrSize,
                         .typelinks_len = 43 * ptrSize,
                         .itablinks_ptr = 45 * ptrSize,
-                        .itablinks_len = 46 * ptrSize
+                        .itablinks_len = 46 * ptrSize,
+                        .gofunc = 38 * ptrSize
                 };
             } else if (version >= go::Version{1, 16}) {
                 return Offsets{
@@ -43,7 +46,8 @@ namespace go {
                         .typelinks_ptr = 40 * ptrSize,
                         .typelinks_len = 41 * ptrSize,
                         .itablinks_ptr = 43 * ptrSize,
-                        .itablinks_len = 44 * ptrSize
+                        .itablinks_len = 44 * ptrSize,
+                        .gofunc = 0
                 };
             } else if (version >= go::Version{1, 10}) {
                 return Offsets{
@@ -52,7 +56,8 @@ namespace go {
                         .typelinks_ptr = 30 * ptrSize,
                         .typelinks_len = 31 * ptrSize,
                         .itablinks_ptr = 33 * ptrSize,
-                        .itablinks_len = 34 * ptrSize
+                        .itablinks_len = 34 * ptrSize,
+                        .gofunc = 0
                 };
             }
 
@@ -0,0 +1,109 @@
+#ifndef GO_SYMBOL_PROTOCOL_H
+#define GO_SYMBOL_PROTOCOL_H
+
+#include <cstdint>
+
+// wire format of the symbolization daemon. the socket is local, so every integer is in host byte order.
+// a message is a Header followed by `length` payload bytes, requests may be pipelined and are answered in order.
+// strings in responses are offsets into a block of NUL terminated names that ends the payload, NO_STRING if absent.
+namespace go::symbol::protocol {
+    constexpr uint32_t MAX_PAYLOAD = 64 << 20;
+    constexpr uint32_t NO_STRING = UINT32_MAX;
+
+    enum MessageType {
+        SYMBOLIZE = 1,
+        FIELD_OFFSETS = 2,
+        BUILD_INFO = 3
+    };
+
+    enum Status {
+        STATUS_OK,
+        STATUS_MALFORMED,
+        STATUS_UNKNOWN_TYPE,
+        STATUS_TOO_LARGE,
+        STATUS_OPEN_FAILED,
+        STATUS_NOT_FOUND
+    };
+
+    struct Header {
+        uint32_t length;
+        uint32_t id;
+        uint16_t type;
+        uint16_t status;
+    };
+
+    // followed by the path, zero padded to a multiple of 8 bytes, then `count` uint64_t pcs.
+    struct SymbolizeRequest {
+        uint64_t base;
+        uint32_t count;
+        uint32_t pathLength;
+    };
+
+    // followed by `count` FrameRecord in request order, then the string block.
+    struct SymbolizeResponse {
+        uint32_t count;
+        uint32_t stringsSize;
+    };
+
+    // unknown pcs have entry 0 and line -1.
+    struct FrameRecord {
+        uint64_t entry;
+        uint32_t name;
+        uint32_t file;
+        int32_t line;
+        uint32_t reserved;
+    };
+
+    // followed by the path, then the type name.
+    struct FieldOffsetsRequest {
+        uint32_t pathLength;
+        uint32_t typeLength;
+    };
+
+    // followed by `count` FieldRecord in declaration order, then the string block.
+    struct FieldOffsetsResponse {
+        uint32_t count;
+        uint32_t stringsSize;
+    };
+
+    struct FieldRecord {
+        uint64_t offset;
+        uint32_t name;
+        uint32_t reserved;
+    };
+
+    // followed by the path.
+    struct BuildInfoRequest {
+        uint32_t pathLength;
+        uint32_t reserved;
+    };
+
+    // followed by `count` ModuleRecord, the main module first, then the string block.
+    struct BuildInfoResponse {
+        uint16_t major;
+        uint16_t minor;
+        uint32_t count;
+        uint32_t stringsSize;
+        uint32_t buildID;
+        uint32_t package;
+        uint32_t reserved;
+    };
+
+    struct ModuleRecord {
+        uint32_t path;
+        uint32_t version;
+        uint32_t sum;
+        uint32_t replacePath;
+        uint32_t replaceVersion;
+        uint32_t replaceSum;
+    };
+
+    static_assert(sizeof(Header) == 12);
+    static_assert(sizeof(SymbolizeRequest) == 16);
+    static_assert(sizeof(FrameRecord) == 24);
+    static_assert(sizeof(FieldRecord) == 16);
+    static_assert(sizeof(BuildInfoResponse) == 24);
+    static_assert(sizeof(ModuleRecord) == 24);
+}
+
+#endif //GO_SYMBOL_PROTOCOL_H
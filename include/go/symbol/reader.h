@@ -3,6 +3,10 @@
 
 
 #include <go/symbol/symbol.h>
+#include <go/symbol/func_table.h>
+#include <go/symbol/mixed.h>
+#include <go/symbol/inline.h>
+#include <go/symbol/arg_layout.h>
 #include <go/symbol/interface.h>
 #include <go/symbol/build_info.h>
 #include <go/symbol/struct.h>
@@ -23,18 +27,49 @@ namespace go::symbol {
     public:
         Reader(elf::Reader reader, std::filesystem::path path);
 
-    private:
+    public:
         size_t ptrSize();
 
+    private:
         elf::endian::Type endian();
 
     public:
         std::optional<Version> version();
+        std::optional<std::string> buildID();
+        std::optional<uint64_t> imageBase();
+        std::shared_ptr<elf::ISection> section(const std::string &name);
 
     public:
         std::optional<BuildInfo> buildInfo();
-        std::optional<seek::SymbolTable> symbols(uint64_t base = 0);
-        std::optional<SymbolTable> symbols(AccessMethod method, uint64_t base = 0);
+
+    public:
+        // validation is the number of threads that check a table up front, 0 keeps every lookup bounds checked.
+        // it reads every pc table, including those a partial copy leaves in the file, so it is never on by default.
+        std::optional<seek::SymbolTable> symbols(uint64_t base = 0, size_t validation = 0);
+        std::optional<SymbolTable> symbols(
+                AccessMethod method,
+                uint64_t base = 0,
+                int hints = NoHint,
+                int queries = QueryAll,
+                size_t validation = 0
+        );
+        std::optional<CompactFuncTable> compactSymbols(uint64_t base = 0, int queries = QueryAll);
+        std::optional<BasicSymbolTable<source::File>> fileSymbols(uint64_t base = 0, size_t validation = 0);
+        std::optional<BasicSymbolTable<source::CachedFile>> cachedSymbols(
+                uint64_t base = 0,
+                size_t pages = 256,
+                size_t validation = 0
+        );
+        std::optional<BasicSymbolTable<source::Process>> processSymbols(
+                pid_t pid,
+                uint64_t base = 0,
+                size_t validation = 0
+        );
+
+    public:
+        std::optional<MixedSymbolizer> mixedSymbolizer(uint64_t base = 0);
+        std::optional<InlineUnwinder> inlineUnwinder(uint64_t base = 0);
+        std::optional<ArgLayoutDecoder> argLayoutDecoder(uint64_t base = 0);
         std::optional<InterfaceTable> interfaces(uint64_t base = 0);
         std::optional<StructTable> typeLinks(uint64_t base = 0);
         std::optional<std::string> findSymtabByKey(const std::string &key);
@@ -48,6 +83,8 @@ namespace go::symbol {
         std::optional<uint64_t> findModuleData();
         bool validateModuleData(uint64_t address, uint64_t pclntab_address);
         bool findSymtabSymbol();
+        std::optional<std::pair<std::shared_ptr<elf::ISection>, SymbolVersion>> symbolSection();
+        std::optional<uint64_t> funcDataBase(SymbolVersion version);
         std::optional<std::pair<std::shared_ptr<elf::ISection>, uint64_t>> findSectionAndBase(const std::string& sectionName, uint64_t base);
 
 
@@ -0,0 +1,55 @@
+#ifndef GO_SYMBOL_REGISTRY_H
+#define GO_SYMBOL_REGISTRY_H
+
+#include <go/symbol/reader.h>
+#include <map>
+#include <mutex>
+
+namespace go::symbol {
+    class SharedSymbolTable {
+    public:
+        SharedSymbolTable(std::shared_ptr<const SymbolTable> table, uint64_t bias);
+
+    public:
+        [[nodiscard]] SymbolIterator find(uint64_t address) const;
+        [[nodiscard]] uint64_t address(const SymbolEntry &entry) const;
+
+    public:
+        [[nodiscard]] uint64_t bias() const;
+        [[nodiscard]] const SymbolTable &table() const;
+
+    private:
+        uint64_t mBias;
+        std::shared_ptr<const SymbolTable> mTable;
+    };
+
+    // tables are copied by default, every process sharing a mapped one faults once the binary is rewritten in place.
+    // attached tables describe the running process rather than a path, so the registry refuses them.
+    class Registry {
+    public:
+        explicit Registry(AccessMethod method = AnonymousMemory, int hints = NoHint);
+
+    public:
+        std::optional<SharedSymbolTable> acquire(const std::filesystem::path &path, uint64_t base = 0);
+
+    public:
+        size_t size();
+
+    private:
+        struct Image {
+            SymbolTable table;
+            std::optional<uint64_t> base;
+        };
+
+        static SharedSymbolTable bind(const std::shared_ptr<const Image> &image, uint64_t base);
+
+    private:
+        int mHints;
+        AccessMethod mMethod;
+        std::mutex mMutex;
+        std::map<std::string, std::string> mFiles;
+        std::map<std::string, std::weak_ptr<const Image>> mImages;
+    };
+}
+
+#endif //GO_SYMBOL_REGISTRY_H
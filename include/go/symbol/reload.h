@@ -0,0 +1,65 @@
+#ifndef GO_SYMBOL_RELOAD_H
+#define GO_SYMBOL_RELOAD_H
+
+#include <go/symbol/registry.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <condition_variable>
+
+namespace go::symbol {
+    // tables are copied out of the binary, a mapping would fault once the file is rewritten in place.
+    class ReloadableSymbolTable {
+    public:
+        explicit ReloadableSymbolTable(
+                std::filesystem::path path,
+                std::chrono::milliseconds interval = std::chrono::seconds(5),
+                AccessMethod method = AnonymousMemory,
+                int hints = NoHint
+        );
+
+        ReloadableSymbolTable(const ReloadableSymbolTable &) = delete;
+        ~ReloadableSymbolTable();
+
+    public:
+        ReloadableSymbolTable &operator=(const ReloadableSymbolTable &) = delete;
+
+    public:
+        [[nodiscard]] std::shared_ptr<const SymbolTable> current() const;
+        [[nodiscard]] std::optional<SharedSymbolTable> acquire(uint64_t base = 0) const;
+        [[nodiscard]] uint64_t generation() const;
+
+    public:
+        bool poll();
+        void stop();
+
+    private:
+        struct Image {
+            SymbolTable table;
+            std::optional<uint64_t> base;
+            std::optional<std::string> buildID;
+        };
+
+        std::optional<std::string> identity() const;
+
+    private:
+        int mHints;
+        AccessMethod mMethod;
+        std::filesystem::path mPath;
+        std::chrono::milliseconds mInterval;
+
+    private:
+        std::mutex mReloadMutex;
+        std::string mIdentity;
+        std::atomic<uint64_t> mGeneration{0};
+        std::shared_ptr<const Image> mImage;
+
+    private:
+        bool mStopped{false};
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::thread mThread;
+    };
+}
+
+#endif //GO_SYMBOL_RELOAD_H
@@ -0,0 +1,78 @@
+#ifndef GO_SYMBOL_SERVER_H
+#define GO_SYMBOL_SERVER_H
+
+#include <go/symbol/registry.h>
+#include <go/symbol/protocol.h>
+#include <go/symbol/type_index.h>
+#include <list>
+#include <sys/types.h>
+#include <thread>
+
+namespace go::symbol {
+    constexpr auto DEFAULT_SERVER_BINARIES = 64;
+    constexpr auto DEFAULT_SOCKET_MODE = 0600;
+
+    // tables are copied by default, a binary rebuilt in place would otherwise change under a mapped table.
+    // at most capacity binaries stay resident, the least recently requested one is dropped first.
+    class Server {
+    public:
+        explicit Server(
+                std::filesystem::path path,
+                AccessMethod method = AnonymousMemory,
+                int hints = NoHint,
+                size_t capacity = DEFAULT_SERVER_BINARIES,
+                mode_t mode = DEFAULT_SOCKET_MODE
+        );
+        Server(const Server &) = delete;
+        ~Server();
+
+    public:
+        Server &operator=(const Server &) = delete;
+
+    public:
+        bool listen();
+        void serve();
+        void stop();
+
+    private:
+        // everything a reply needs is read when the binary is loaded, no file mapping outlives that.
+        struct Binary {
+            std::string identity;
+            SharedSymbolTable table;
+            std::optional<uint64_t> imageBase;
+            std::shared_ptr<const TypeIndex> types;
+            std::vector<std::byte> buildInfo;
+        };
+
+        struct Connection {
+            std::thread thread;
+            std::shared_ptr<std::atomic<bool>> done;
+        };
+
+        std::shared_ptr<Binary> binary(const std::string &path);
+        void handle(int fd);
+
+    private:
+        uint16_t dispatch(uint16_t type, const std::byte *payload, size_t length, std::vector<std::byte> &response);
+        uint16_t symbolize(const std::byte *payload, size_t length, std::vector<std::byte> &response);
+        uint16_t fieldOffsets(const std::byte *payload, size_t length, std::vector<std::byte> &response);
+        uint16_t buildInfo(const std::byte *payload, size_t length, std::vector<std::byte> &response);
+
+    private:
+        int mFD{-1};
+        int mWakeup[2]{-1, -1};
+        mode_t mMode;
+        size_t mCapacity;
+        std::atomic<bool> mStopped{false};
+        std::filesystem::path mPath;
+        Registry mRegistry;
+
+    private:
+        std::mutex mMutex;
+        std::list<std::pair<std::string, std::shared_ptr<Binary>>> mBinaries;
+        std::map<std::string, std::list<std::pair<std::string, std::shared_ptr<Binary>>>::iterator> mPaths;
+        std::list<Connection> mConnections;
+    };
+}
+
+#endif //GO_SYMBOL_SERVER_H
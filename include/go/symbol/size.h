@@ -0,0 +1,25 @@
+#ifndef GO_SYMBOL_SIZE_H
+#define GO_SYMBOL_SIZE_H
+
+#include <go/symbol/reader.h>
+
+namespace go::symbol {
+    struct SizeEntry {
+        std::string name;
+        uint64_t size;
+        uint64_t count;
+    };
+
+    struct SizeReport {
+        uint64_t text;
+        TableLayout pclntab;
+        std::vector<SizeEntry> packages;
+        std::vector<SizeEntry> files;
+        std::vector<SizeEntry> types;
+        std::vector<SizeEntry> itabs;
+    };
+
+    std::optional<SizeReport> attributeSizes(Reader &reader, size_t concurrency = 1);
+}
+
+#endif //GO_SYMBOL_SIZE_H
@@ -0,0 +1,139 @@
+#ifndef GO_SYMBOL_SOURCE_H
+#define GO_SYMBOL_SOURCE_H
+
+#include <elf/reader.h>
+#include <variant>
+#include <fstream>
+#include <mutex>
+#include <cstring>
+#include <sys/types.h>
+
+namespace go::symbol::source {
+    class Memory {
+    public:
+        using String = const char *;
+        using Buffer = std::variant<
+                std::shared_ptr<elf::ISection>,
+                std::unique_ptr<std::byte[]>,
+                const std::byte *,
+                std::shared_ptr<std::byte[]>
+        >;
+
+        static constexpr bool CONTIGUOUS = true;
+        static constexpr bool CONCURRENT = true;
+
+    public:
+        Memory(Buffer buffer, size_t size);
+
+    public:
+        [[nodiscard]] size_t size() const {
+            return mSize;
+        }
+
+        [[nodiscard]] const std::byte *data() const {
+            return mData;
+        }
+
+        bool read(uint64_t offset, void *buffer, size_t length) const {
+            if (offset > mSize || length > mSize - offset)
+                return false;
+
+            memcpy(buffer, mData + offset, length);
+            return true;
+        }
+
+    private:
+        size_t mSize;
+        Buffer mBuffer;
+        const std::byte *mData;
+    };
+
+    class Stream {
+    public:
+        using String = std::string;
+        static constexpr bool CONTIGUOUS = false;
+        static constexpr bool CONCURRENT = false;
+
+    public:
+        Stream(std::ifstream stream, std::streamoff offset, size_t size);
+
+    public:
+        [[nodiscard]] size_t size() const;
+        bool read(uint64_t offset, void *buffer, size_t length) const;
+
+    private:
+        size_t mSize;
+        std::streamoff mOffset;
+        mutable std::ifstream mStream;
+    };
+
+    class File {
+    public:
+        using String = std::string;
+        static constexpr bool CONTIGUOUS = false;
+        static constexpr bool CONCURRENT = true;
+
+    public:
+        File(int fd, off_t offset, size_t size);
+
+    public:
+        [[nodiscard]] size_t size() const;
+        bool read(uint64_t offset, void *buffer, size_t length) const;
+
+    public:
+        [[nodiscard]] int fd() const;
+        [[nodiscard]] off_t offset() const;
+
+    private:
+        size_t mSize;
+        off_t mOffset;
+        std::shared_ptr<int> mFD;
+    };
+
+    class CachedFile {
+    public:
+        using String = std::string;
+        static constexpr bool CONTIGUOUS = false;
+        static constexpr bool CONCURRENT = true;
+
+    public:
+        CachedFile(File file, size_t pages);
+
+    public:
+        [[nodiscard]] size_t size() const;
+        bool read(uint64_t offset, void *buffer, size_t length) const;
+
+    private:
+        struct Cache {
+            std::mutex mutex;
+            std::vector<uint64_t> tags;
+            std::unique_ptr<std::byte[]> pages;
+        };
+
+    private:
+        File mFile;
+        size_t mPages;
+        std::shared_ptr<Cache> mCache;
+    };
+
+    class Process {
+    public:
+        using String = std::string;
+        static constexpr bool CONTIGUOUS = false;
+        static constexpr bool CONCURRENT = true;
+
+    public:
+        Process(pid_t pid, uint64_t address, size_t size);
+
+    public:
+        [[nodiscard]] size_t size() const;
+        bool read(uint64_t offset, void *buffer, size_t length) const;
+
+    private:
+        pid_t mPID;
+        size_t mSize;
+        uint64_t mAddress;
+    };
+}
+
+#endif //GO_SYMBOL_SOURCE_H
@@ -1,10 +1,14 @@
 #ifndef GO_SYMBOL_SYMBOL_H
 #define GO_SYMBOL_SYMBOL_H
 
-#include <variant>
-#include <elf/reader.h>
+#include <go/symbol/source.h>
 #include <go/endian.h>
-#include <fstream>
+#include <go/binary.h>
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
 
 namespace go::symbol {
     enum SymbolVersion {
@@ -14,260 +18,1338 @@ namespace go::symbol {
         VERSION120
     };
 
-    class SymbolEntry;
-    class SymbolIterator;
+    enum MappingHint {
+        NoHint = 0,
+        RandomPCTable = 1 << 0,
+        WillNeedFuncTable = 1 << 1,
+        WillNeedNameTable = 1 << 2,
+        PopulateTables = 1 << 3,
+        HugePages = 1 << 4
+    };
+
+    enum SymbolQuery {
+        QueryName = 1 << 0,
+        QuerySourceFile = 1 << 1,
+        QuerySourceLine = 1 << 2,
+        QueryFrameSize = 1 << 3,
+        QueryAll = QueryName | QuerySourceFile | QuerySourceLine | QueryFrameSize
+    };
+
+    enum FuncID {
+        FUNC_ID_NORMAL,
+        FUNC_ID_ABORT,
+        FUNC_ID_ASM_CGO_CALL,
+        FUNC_ID_ASYNC_PREEMPT,
+        FUNC_ID_CGO_CALLBACK,
+        FUNC_ID_CORO_START,
+        FUNC_ID_DEBUG_CALL,
+        FUNC_ID_EXTERNAL_THREAD_HANDLER,
+        FUNC_ID_GC_BG_MARK_WORKER,
+        FUNC_ID_GO_EXIT,
+        FUNC_ID_GO_GO,
+        FUNC_ID_GO_PANIC,
+        FUNC_ID_HANDLE_ASYNC_EVENT,
+        FUNC_ID_JMP_DEFER,
+        FUNC_ID_LESS_STACK,
+        FUNC_ID_MCALL,
+        FUNC_ID_MORE_STACK,
+        FUNC_ID_MSTART,
+        FUNC_ID_PANIC_WRAP,
+        FUNC_ID_RT0_GO,
+        FUNC_ID_RUN_FINQ,
+        FUNC_ID_RUNTIME_MAIN,
+        FUNC_ID_SIG_PANIC,
+        FUNC_ID_SYSTEM_STACK,
+        FUNC_ID_SYSTEM_STACK_SWITCH,
+        FUNC_ID_WRAPPER
+    };
+
+    enum FuncFlag {
+        FUNC_FLAG_TOP_FRAME = 1 << 0,
+        FUNC_FLAG_SP_WRITE = 1 << 1,
+        FUNC_FLAG_ASM = 1 << 2
+    };
+
+    enum PCDataTable {
+        PCDATA_UNSAFE_POINT,
+        PCDATA_STACK_MAP_INDEX,
+        PCDATA_INL_TREE_INDEX,
+        PCDATA_ARG_LIVE_INDEX
+    };
+
+    enum FuncDataIndex {
+        FUNCDATA_ARGS_POINTER_MAPS,
+        FUNCDATA_LOCALS_POINTER_MAPS,
+        FUNCDATA_STACK_OBJECTS,
+        FUNCDATA_INL_TREE,
+        FUNCDATA_OPEN_CODED_DEFER_INFO,
+        FUNCDATA_ARG_INFO,
+        FUNCDATA_ARG_LIVE_INFO,
+        FUNCDATA_WRAP_INFO
+    };
+
+    using FuncIDMap = std::array<FuncID, 256>;
+
+    struct TableLayout {
+        uint64_t header;
+        uint64_t names;
+        uint64_t units;
+        uint64_t files;
+        uint64_t pcs;
+        uint64_t functions;
+    };
+
+    struct FunctionArrays {
+        std::vector<uint64_t> entries;
+        std::vector<uint64_t> ends;
+        std::vector<uint32_t> nameOffsets;
+        std::string names;
+        std::vector<int32_t> startLines;
+        std::vector<int32_t> frameSizes;
+        std::vector<uint8_t> funcIDs;
+        std::vector<uint32_t> fileIDs;
+    };
+
+    std::optional<SymbolVersion> symbolVersion(uint32_t magic);
+
+    namespace detail {
+        constexpr auto MAX_VAR_INT_LENGTH = 10;
+        constexpr auto CURSOR_BUFFER_SIZE = 512;
+        constexpr auto MIN_PARALLEL_FUNCTIONS = 1024;
+
+        std::optional<FuncID> lookupFuncID(std::string_view name);
+        std::vector<const FuncIDMap *> funcIDMaps(SymbolVersion version);
+        bool isStackTopFuncID(FuncID id);
+
+        void willNeed(const std::byte *begin, const std::byte *end, bool populate);
+        void randomAccess(const std::byte *begin, const std::byte *end);
+
+        template<typename Source, bool = Source::CONTIGUOUS>
+        class Cursor {
+        public:
+            Cursor(const Source &source, uint64_t offset) : mBuffer(source.data() + offset) {
+
+            }
+
+        public:
+            const std::byte *peek(size_t) {
+                return mBuffer;
+            }
+
+            void skip(size_t length) {
+                mBuffer += length;
+            }
+
+        private:
+            const std::byte *mBuffer;
+        };
+
+        template<typename Source>
+        class Cursor<Source, false> {
+        public:
+            Cursor(const Source &source, uint64_t offset) : mOffset(offset), mSource(source) {
+
+            }
+
+        public:
+            const std::byte *peek(size_t length) {
+                if (mPosition + length <= mLength)
+                    return mBuffer + mPosition;
+
+                mOffset += mPosition;
+                mPosition = 0;
+                mLength = mOffset < mSource.size() ? std::min<uint64_t>(sizeof(mBuffer), mSource.size() - mOffset) : 0;
+
+                if (!mSource.read(mOffset, mBuffer, mLength))
+                    mLength = 0;
+
+                // a truncated read decodes as zeros, which every varint loop treats as the end of its stream.
+                std::fill(mBuffer + mLength, mBuffer + sizeof(mBuffer), std::byte{0});
+
+                return mBuffer;
+            }
+
+            void skip(size_t length) {
+                mPosition += length;
+            }
+
+        private:
+            uint64_t mOffset;
+            size_t mLength{};
+            size_t mPosition{};
+            const Source &mSource;
+            std::byte mBuffer[CURSOR_BUFFER_SIZE];
+        };
+    }
+
+    template<typename Source>
+    class BasicSymbol;
+
+    template<typename Source>
+    class BasicSymbolEntry;
+
+    template<typename Source>
+    class BasicSymbolIterator;
+
+    template<typename Source>
+    class BasicNameIndex;
+
+    template<typename Source>
+    class BasicLineIndex;
+
+    template<typename Source>
+    class BasicUnwindTable;
+
+    class BatchSymbolizer;
+    class InlineUnwinder;
+    class CompactFuncTable;
 
-    class SymbolTable {
-        using MemoryBuffer = std::variant<std::shared_ptr<elf::ISection>, std::unique_ptr<std::byte[]>, const std::byte *>;
+    template<typename Source>
+    class BasicSymbolTable {
     public:
-        SymbolTable(SymbolVersion version, endian::Converter converter, MemoryBuffer memoryBuffer, uint64_t base);
+        using String = typename Source::String;
 
     public:
-        [[nodiscard]] SymbolIterator find(uint64_t address) const;
-        [[nodiscard]] SymbolIterator find(std::string_view name) const;
+        BasicSymbolTable(SymbolVersion version, endian::Converter converter, Source source, uint64_t base);
+
+    public:
+        [[nodiscard]] BasicSymbolIterator<Source> find(uint64_t address) const;
+        [[nodiscard]] BasicSymbolIterator<Source> find(std::string_view name) const;
 
     public:
         [[nodiscard]] size_t size() const;
+        [[nodiscard]] const Source &source() const;
+        [[nodiscard]] SymbolVersion version() const;
+
+    public:
+        [[nodiscard]] BasicSymbolEntry<Source> operator[](size_t index) const;
 
     public:
-        [[nodiscard]] SymbolEntry operator[](size_t index) const;
+        // views point into the section for contiguous sources. other sources intern every string they return
+        // for the lifetime of the table, indices hold on to the views, so the cache is never trimmed. it is keyed
+        // by table offset, which caps it at one copy of the name and file tables.
+        [[nodiscard]] std::string_view functionName(size_t index) const;
+        [[nodiscard]] std::string_view fileName(uint32_t id) const;
 
     public:
-        [[nodiscard]] SymbolIterator begin() const;
-        [[nodiscard]] SymbolIterator end() const;
+        [[nodiscard]] BasicSymbolIterator<Source> begin() const;
+        [[nodiscard]] BasicSymbolIterator<Source> end() const;
+
+    public:
+        void advise(int hints) const;
+        [[nodiscard]] std::vector<std::pair<uint64_t, uint64_t>> regions(int queries) const;
+        [[nodiscard]] TableLayout layout() const;
+
+    public:
+        bool validate(size_t concurrency = 1);
+        [[nodiscard]] bool validated() const;
+
+    public:
+        [[nodiscard]] FunctionArrays functions(size_t concurrency = 1) const;
+
+    private:
+        [[nodiscard]] bool validateFiles() const;
+        [[nodiscard]] bool validateFunctions(size_t begin, size_t end) const;
+        [[nodiscard]] bool terminated(uint64_t offset, uint64_t end) const;
+        [[nodiscard]] std::optional<int> walk(uint64_t offset, uint64_t end) const;
+
+    private:
+        void functions(FunctionArrays &arrays, size_t begin, size_t end) const;
+
+    private:
+        [[nodiscard]] uint64_t entry(size_t index) const;
+        [[nodiscard]] uint64_t funcOffset(size_t index) const;
+
+    private:
+        [[nodiscard]] uint64_t integer(uint64_t offset, size_t size) const;
+        [[nodiscard]] String string(uint64_t offset) const;
+        [[nodiscard]] std::string_view view(uint64_t offset) const;
+        [[nodiscard]] uint64_t fileOffset(uint32_t id) const;
+
+    private:
+        template<typename F>
+        void runs(uint32_t offset, uint64_t entry, F &&f) const;
+
+        template<typename Cursor, typename F>
+        void runs(Cursor cursor, uint64_t entry, F &&f) const;
+
+        [[nodiscard]] int value(uint32_t offset, uint64_t entry, uint64_t target) const;
+        [[nodiscard]] std::optional<uint32_t> fileID(uint32_t cu, int n) const;
+        void resolveFuncIDs();
+
+    private:
+        struct Strings {
+            std::mutex mutex;
+            std::unordered_map<uint64_t, std::string> strings;
+        };
 
     private:
-        [[nodiscard]] const std::byte *data() const;
+        bool mIntact{true};
+        bool mValidated{false};
 
     private:
         uint64_t mBase;
+        Source mSource;
         SymbolVersion mVersion;
-        MemoryBuffer mMemoryBuffer;
         endian::Converter mConverter;
+        std::shared_ptr<Strings> mStrings{std::make_shared<Strings>()};
+        const FuncIDMap *mFuncIDs{};
 
     private:
         uint32_t mQuantum{};
         uint32_t mPtrSize{};
         uint32_t mFuncNum{};
         uint32_t mFileNum{};
+        uint32_t mEntrySize{};
 
     private:
-        const std::byte *mFuncNameTable{};
-        const std::byte *mCuTable{};
-        const std::byte *mFuncTable{};
-        const std::byte *mFuncData{};
-        const std::byte *mPCTable{};
-        const std::byte *mFileTable{};
-
-        friend class Symbol;
-        friend class SymbolEntry;
-        friend class SymbolIterator;
+        uint64_t mFuncNameTable{};
+        uint64_t mCuTable{};
+        uint64_t mFuncTable{};
+        uint64_t mFuncData{};
+        uint64_t mPCTable{};
+        uint64_t mFileTable{};
+
+    private:
+        const std::byte *mFuncTableData{};
+        std::shared_ptr<std::byte[]> mFuncTableBuffer;
+
+        friend class BasicSymbol<Source>;
+        friend class BasicSymbolEntry<Source>;
+        friend class BasicSymbolIterator<Source>;
+        friend class BasicNameIndex<Source>;
+        friend class BasicLineIndex<Source>;
+        friend class BasicUnwindTable<Source>;
+        friend class BatchSymbolizer;
+        friend class InlineUnwinder;
+        friend class CompactFuncTable;
     };
 
-    class Symbol {
+    template<typename Source>
+    class BasicSymbol {
     public:
-        Symbol(const SymbolTable *table, const std::byte *buffer);
+        using String = typename Source::String;
+
+    public:
+        BasicSymbol(const BasicSymbolTable<Source> *table, uint64_t offset);
 
     public:
         [[nodiscard]] uint64_t entry() const;
-        [[nodiscard]] const char *name() const;
+        [[nodiscard]] String name() const;
 
     public:
         [[nodiscard]] int frameSize(uint64_t pc) const;
         [[nodiscard]] int sourceLine(uint64_t pc) const;
-        [[nodiscard]] const char *sourceFile(uint64_t pc) const;
+        [[nodiscard]] String sourceFile(uint64_t pc) const;
+        [[nodiscard]] std::optional<uint32_t> fileID(uint64_t pc) const;
 
     public:
+        [[nodiscard]] FuncID funcID() const;
+        [[nodiscard]] uint8_t flags() const;
         [[nodiscard]] bool isStackTop() const;
 
+    public:
+        [[nodiscard]] int pcData(int table, uint64_t pc) const;
+        [[nodiscard]] std::optional<uint64_t> funcData(int index) const;
+
     private:
         [[nodiscard]] uint32_t field(int n) const;
+        [[nodiscard]] uint8_t rawFuncID() const;
+        [[nodiscard]] uint64_t trailer() const;
 
     private:
-        [[nodiscard]] int value(uint32_t offset, uint64_t entry, uint64_t target) const;
+        uint64_t mOffset;
+        const BasicSymbolTable<Source> *mTable;
 
-    private:
-        const std::byte *mBuffer;
-        const SymbolTable *mTable;
+        friend class BasicSymbolTable<Source>;
+        friend class BasicNameIndex<Source>;
+        friend class BasicLineIndex<Source>;
+        friend class BasicUnwindTable<Source>;
     };
 
-    class SymbolEntry {
+    template<typename Source>
+    class BasicSymbolEntry {
     public:
-        SymbolEntry(const SymbolTable *table, uint64_t entry, uint64_t offset);
+        BasicSymbolEntry(const BasicSymbolTable<Source> *table, uint64_t entry, uint64_t offset, size_t index);
 
     public:
+        [[nodiscard]] size_t index() const;
         [[nodiscard]] uint64_t entry() const;
-        [[nodiscard]] Symbol symbol() const;
+        [[nodiscard]] BasicSymbol<Source> symbol() const;
 
     private:
+        size_t mIndex;
         uint64_t mEntry;
         uint64_t mOffset;
-        const SymbolTable *mTable;
+        const BasicSymbolTable<Source> *mTable;
+
+        friend class CompactFuncTable;
     };
 
-    class SymbolIterator {
+    template<typename Source>
+    class BasicSymbolIterator {
     public:
         using difference_type = std::ptrdiff_t;
-        using value_type = SymbolEntry;
+        using value_type = BasicSymbolEntry<Source>;
         using pointer = value_type *;
         using reference = value_type &;
         using iterator_category = std::random_access_iterator_tag;
 
     public:
-        SymbolIterator(const SymbolTable *table, const std::byte *buffer);
+        BasicSymbolIterator(const BasicSymbolTable<Source> *table, size_t index);
 
     public:
-        SymbolEntry operator*();
-        SymbolIterator &operator--();
-        SymbolIterator &operator++();
-        SymbolIterator &operator+=(std::ptrdiff_t offset);
-        SymbolIterator operator-(std::ptrdiff_t offset);
-        SymbolIterator operator+(std::ptrdiff_t offset);
+        BasicSymbolEntry<Source> operator*();
+        BasicSymbolIterator &operator--();
+        BasicSymbolIterator &operator++();
+        BasicSymbolIterator &operator+=(std::ptrdiff_t offset);
+        BasicSymbolIterator operator-(std::ptrdiff_t offset);
+        BasicSymbolIterator operator+(std::ptrdiff_t offset);
 
     public:
-        bool operator==(const SymbolIterator &rhs);
-        bool operator!=(const SymbolIterator &rhs);
+        bool operator==(const BasicSymbolIterator &rhs);
+        bool operator!=(const BasicSymbolIterator &rhs);
 
     public:
-        std::ptrdiff_t operator-(const SymbolIterator &rhs);
+        std::ptrdiff_t operator-(const BasicSymbolIterator &rhs);
 
     private:
-        size_t mSize;
-        const std::byte *mBuffer;
-        const SymbolTable *mTable;
+        size_t mIndex;
+        const BasicSymbolTable<Source> *mTable;
     };
 
+    using SymbolTable = BasicSymbolTable<source::Memory>;
+    using Symbol = BasicSymbol<source::Memory>;
+    using SymbolEntry = BasicSymbolEntry<source::Memory>;
+    using SymbolIterator = BasicSymbolIterator<source::Memory>;
+
     namespace seek {
-        class SymbolEntry;
-        class SymbolIterator;
+        using SymbolTable = BasicSymbolTable<source::Stream>;
+        using Symbol = BasicSymbol<source::Stream>;
+        using SymbolEntry = BasicSymbolEntry<source::Stream>;
+        using SymbolIterator = BasicSymbolIterator<source::Stream>;
+    }
+}
 
-        class SymbolTable {
-        public:
-            SymbolTable(
-                    SymbolVersion
-                    version,
-                    endian::Converter converter,
-                    std::ifstream stream,
-                    std::streamoff offset,
-                    uint64_t address,
-                    uint64_t base
-            );
+template<typename Source>
+go::symbol::BasicSymbolTable<Source>::BasicSymbolTable(
+        SymbolVersion version,
+        endian::Converter converter,
+        Source source,
+        uint64_t base
+) : mBase(base), mSource(std::move(source)), mVersion(version), mConverter(converter) {
+    mQuantum = integer(6, 1);
+    mPtrSize = integer(7, 1);
 
-        public:
-            SymbolIterator find(uint64_t address);
-            SymbolIterator find(std::string_view name);
+    if (mPtrSize != 4 && mPtrSize != 8) {
+        mIntact = false;
+        mPtrSize = 8;
+        mEntrySize = 8;
+        return;
+    }
 
-        public:
-            size_t size() const;
+    switch (mVersion) {
+        case VERSION12: {
+            mFuncNum = integer(8, mPtrSize);
+            mFuncData = 0;
+            mFuncNameTable = 0;
+            mFuncTable = 8 + mPtrSize;
+            mPCTable = 0;
 
-        public:
-            SymbolEntry operator[](size_t index);
+            uint64_t funcTableSize = mFuncNum * 2 * mPtrSize + mPtrSize;
 
-        public:
-            SymbolIterator begin();
-            SymbolIterator end();
+            mFileTable = integer(mFuncTable + funcTableSize, 4);
+            mFileNum = integer(mFileTable, 4);
 
-        private:
-            uint64_t mBase;
-            uint64_t mAddress;
-            std::streamoff mOffset;
-            std::ifstream mStream;
-            SymbolVersion mVersion;
-            endian::Converter mConverter;
-            std::unique_ptr<std::byte[]> mFuncTableBuffer;
+            break;
+        }
 
-        private:
-            uint32_t mQuantum{};
-            uint32_t mPtrSize{};
-            uint32_t mFuncNum{};
-            uint32_t mFileNum{};
+        case VERSION116: {
+            mFuncNum = integer(8, mPtrSize);
+            mFileNum = integer(8 + mPtrSize, mPtrSize);
 
-        private:
-            uint64_t mFuncNameTable{};
-            uint64_t mCuTable{};
-            uint64_t mFuncTable{};
-            uint64_t mFuncData{};
-            uint64_t mPCTable{};
-            uint64_t mFileTable{};
-
-            friend class Symbol;
-            friend class SymbolEntry;
-            friend class SymbolIterator;
-        };
+            mFuncNameTable = integer(8 + 2 * mPtrSize, mPtrSize);
+            mCuTable = integer(8 + 3 * mPtrSize, mPtrSize);
+            mFileTable = integer(8 + 4 * mPtrSize, mPtrSize);
+            mPCTable = integer(8 + 5 * mPtrSize, mPtrSize);
+            mFuncData = integer(8 + 6 * mPtrSize, mPtrSize);
+            mFuncTable = integer(8 + 6 * mPtrSize, mPtrSize);
 
-        class Symbol {
-        public:
-            Symbol(SymbolTable *table, uint64_t address);
+            break;
+        }
 
-        public:
-            [[nodiscard]] uint64_t entry() const;
-            [[nodiscard]] std::string name() const;
+        case VERSION118:
+        case VERSION120: {
+            mFuncNum = integer(8, mPtrSize);
+            mFileNum = integer(8 + mPtrSize, mPtrSize);
 
-        public:
-            [[nodiscard]] int frameSize(uint64_t pc) const;
-            [[nodiscard]] int sourceLine(uint64_t pc) const;
-            [[nodiscard]] std::string sourceFile(uint64_t pc) const;
+            mBase += integer(8 + 2 * mPtrSize, mPtrSize);
 
-        public:
-            [[nodiscard]] bool isStackTop() const;
+            mFuncNameTable = integer(8 + 3 * mPtrSize, mPtrSize);
+            mCuTable = integer(8 + 4 * mPtrSize, mPtrSize);
+            mFileTable = integer(8 + 5 * mPtrSize, mPtrSize);
+            mPCTable = integer(8 + 6 * mPtrSize, mPtrSize);
+            mFuncData = integer(8 + 7 * mPtrSize, mPtrSize);
+            mFuncTable = integer(8 + 7 * mPtrSize, mPtrSize);
 
-        private:
-            [[nodiscard]] uint32_t field(int n) const;
+            break;
+        }
+    }
 
-        private:
-            [[nodiscard]] int value(uint32_t offset, uint64_t entry, uint64_t target) const;
+    mEntrySize = mVersion >= VERSION118 ? 4 : mPtrSize;
 
-        private:
-            uint64_t mAddress;
-            SymbolTable *mTable;
-        };
+    uint64_t size = mSource.size();
 
-        class SymbolEntry {
-        public:
-            SymbolEntry(SymbolTable *table, uint64_t entry, uint64_t offset);
+    if (mVersion != VERSION12 && !(mFuncNameTable <= mCuTable && mCuTable <= mFileTable &&
+                                   mFileTable <= mPCTable && mPCTable <= mFuncTable && mFuncTable <= size))
+        mIntact = false;
 
-        public:
-            [[nodiscard]] uint64_t entry() const;
-            [[nodiscard]] Symbol symbol() const;
+    // the functab is read without checks, so a table claiming more functions than the section holds is cut short.
+    uint64_t capacity = mFuncTable < size ? (size - mFuncTable) / (2 * mEntrySize) : 0;
 
-        private:
-            uint64_t mEntry;
-            uint64_t mOffset;
-            SymbolTable *mTable;
-        };
+    if (mFuncNum + 1 > capacity) {
+        mIntact = false;
+        mFuncNum = capacity > 0 ? capacity - 1 : 0;
+    }
 
-        class SymbolIterator {
-        public:
-            using difference_type = std::ptrdiff_t;
-            using value_type = SymbolEntry;
-            using pointer = value_type *;
-            using reference = value_type &;
-            using iterator_category = std::random_access_iterator_tag;
+    if constexpr (Source::CONTIGUOUS) {
+        mFuncTableData = mSource.data() + mFuncTable;
+    } else {
+        // binary search touches the functab on every lookup, so sources without a mapping keep it resident.
+        uint64_t size = (mFuncNum + 1) * 2 * mEntrySize;
 
-        public:
-            SymbolIterator(SymbolTable *table, const std::byte *buffer);
+        mFuncTableBuffer = std::shared_ptr<std::byte[]>(new std::byte[size]());
+        mFuncTableData = mFuncTableBuffer.get();
 
-        public:
-            SymbolEntry operator*();
-            SymbolIterator &operator--();
-            SymbolIterator &operator++();
-            SymbolIterator &operator+=(std::ptrdiff_t offset);
-            SymbolIterator operator-(std::ptrdiff_t offset);
-            SymbolIterator operator+(std::ptrdiff_t offset);
+        mSource.read(mFuncTable, mFuncTableBuffer.get(), size);
+    }
 
-        public:
-            bool operator==(const SymbolIterator &rhs);
-            bool operator!=(const SymbolIterator &rhs);
+    if (mVersion != VERSION12)
+        resolveFuncIDs();
+}
 
-        public:
-            std::ptrdiff_t operator-(const SymbolIterator &rhs);
+template<typename Source>
+go::symbol::BasicSymbolIterator<Source> go::symbol::BasicSymbolTable<Source>::find(uint64_t address) const {
+    if (mFuncNum == 0 || address < entry(0) || address >= entry(mFuncNum))
+        return end();
 
-        private:
-            size_t mSize;
-            SymbolTable *mTable;
-            const std::byte *mBuffer;
-        };
+    return std::upper_bound(begin(), end() + 1, address, [](uint64_t value, const auto &entry) {
+        return value < entry.entry();
+    }) - 1;
+}
+
+template<typename Source>
+go::symbol::BasicSymbolIterator<Source> go::symbol::BasicSymbolTable<Source>::find(std::string_view name) const {
+    return std::find_if(begin(), end(), [=](const auto &entry) {
+        return name == entry.symbol().name();
+    });
+}
+
+template<typename Source>
+size_t go::symbol::BasicSymbolTable<Source>::size() const {
+    return mFuncNum;
+}
+
+template<typename Source>
+const Source &go::symbol::BasicSymbolTable<Source>::source() const {
+    return mSource;
+}
+
+template<typename Source>
+go::symbol::SymbolVersion go::symbol::BasicSymbolTable<Source>::version() const {
+    return mVersion;
+}
+
+template<typename Source>
+go::symbol::BasicSymbolEntry<Source> go::symbol::BasicSymbolTable<Source>::operator[](size_t index) const {
+    return {this, entry(index), funcOffset(index), index};
+}
+
+template<typename Source>
+std::string_view go::symbol::BasicSymbolTable<Source>::functionName(size_t index) const {
+    return view(mFuncNameTable + operator[](index).symbol().field(1));
+}
+
+template<typename Source>
+std::string_view go::symbol::BasicSymbolTable<Source>::fileName(uint32_t id) const {
+    return view(fileOffset(id));
+}
+
+template<typename Source>
+go::symbol::BasicSymbolIterator<Source> go::symbol::BasicSymbolTable<Source>::begin() const {
+    return {this, 0};
+}
+
+template<typename Source>
+go::symbol::BasicSymbolIterator<Source> go::symbol::BasicSymbolTable<Source>::end() const {
+    return {this, mFuncNum};
+}
+
+template<typename Source>
+void go::symbol::BasicSymbolTable<Source>::advise(int hints) const {
+    // only mapped sources are paged in by the kernel, the others have nothing to advise.
+    if constexpr (Source::CONTIGUOUS) {
+        const std::byte *buffer = mSource.data();
+
+        if (hints & WillNeedFuncTable)
+            detail::willNeed(mFuncTableData, mFuncTableData + (mFuncNum + 1) * 2 * mEntrySize, hints & PopulateTables);
+
+        // since go 1.16, the name table, cu table, file table and pc table are laid out back to back before the func table.
+        if (mVersion == VERSION12)
+            return;
+
+        if (hints & WillNeedNameTable)
+            detail::willNeed(buffer + mFuncNameTable, buffer + mCuTable, hints & PopulateTables);
+
+        if (hints & RandomPCTable)
+            detail::randomAccess(buffer + mPCTable, buffer + mFuncTable);
+    }
+}
+
+template<typename Source>
+std::vector<std::pair<uint64_t, uint64_t>> go::symbol::BasicSymbolTable<Source>::regions(int queries) const {
+    // before go 1.16 the tables are interleaved, so the whole section is needed.
+    if (mVersion == VERSION12)
+        return {{0, UINT64_MAX}};
+
+    // the header, functab and _func records back every query.
+    std::vector<std::pair<uint64_t, uint64_t>> regions = {
+            {0,          mFuncNameTable},
+            {mFuncTable, UINT64_MAX}
+    };
+
+    if (queries & QueryName)
+        regions.emplace_back(mFuncNameTable, mCuTable);
+
+    if (queries & QuerySourceFile)
+        regions.emplace_back(mCuTable, mPCTable);
+
+    if (queries & (QuerySourceFile | QuerySourceLine | QueryFrameSize))
+        regions.emplace_back(mPCTable, mFuncTable);
+
+    return regions;
+}
+
+template<typename Source>
+go::symbol::TableLayout go::symbol::BasicSymbolTable<Source>::layout() const {
+    uint64_t size = mSource.size();
+
+    if (!mIntact || mFuncTable > size)
+        return {};
+
+    // before go 1.16 names, files and pc tables are interleaved with the _func records.
+    if (mVersion == VERSION12)
+        return {mFuncTable, 0, 0, 0, 0, size - mFuncTable};
+
+    return {
+            mFuncNameTable,
+            mCuTable - mFuncNameTable,
+            mFileTable - mCuTable,
+            mPCTable - mFileTable,
+            mFuncTable - mPCTable,
+            size - mFuncTable
+    };
+}
+
+template<typename Source>
+bool go::symbol::BasicSymbolTable<Source>::validate(size_t concurrency) {
+    if (mValidated)
+        return true;
+
+    if (!mIntact || !validateFiles())
+        return false;
+
+    if constexpr (!Source::CONCURRENT)
+        concurrency = 1;
+
+    concurrency = std::max<size_t>(1, std::min<size_t>(concurrency, mFuncNum / detail::MIN_PARALLEL_FUNCTIONS));
+
+    size_t step = (mFuncNum + concurrency - 1) / concurrency;
+
+    std::atomic<bool> valid = true;
+    std::vector<std::thread> threads;
+
+    for (size_t i = 1; i < concurrency; i++) {
+        threads.emplace_back([=, &valid]() {
+            if (!validateFunctions(i * step, std::min<size_t>((i + 1) * step, mFuncNum)))
+                valid = false;
+        });
+    }
+
+    if (!validateFunctions(0, std::min<size_t>(step, mFuncNum)))
+        valid = false;
+
+    for (auto &thread: threads)
+        thread.join();
+
+    mValidated = valid;
+    return mValidated;
+}
+
+template<typename Source>
+bool go::symbol::BasicSymbolTable<Source>::validated() const {
+    return mValidated;
+}
+
+template<typename Source>
+bool go::symbol::BasicSymbolTable<Source>::validateFiles() const {
+    uint64_t size = mSource.size();
+
+    if (mVersion == VERSION12) {
+        if (mFileTable > size || (uint64_t(mFileNum) + 1) * 4 > size - mFileTable)
+            return false;
+
+        for (uint32_t i = 1; i <= mFileNum; i++) {
+            if (!terminated(mFuncData + integer(mFileTable + i * 4, 4), size))
+                return false;
+        }
+
+        return true;
+    }
+
+    // every file name lies in the file table, so one terminator at its end bounds all of them.
+    if (mPCTable > mFileTable && integer(mPCTable - 1, 1) != 0)
+        return false;
+
+    detail::Cursor<Source, false> cursor(mSource, mCuTable);
+
+    for (uint64_t i = 0; i < (mFileTable - mCuTable) / 4; i++) {
+        uint64_t offset = mConverter(cursor.peek(4), 4);
+        cursor.skip(4);
+
+        if (offset != UINT32_MAX && mFileTable + offset >= mPCTable)
+            return false;
+    }
+
+    return true;
+}
+
+template<typename Source>
+bool go::symbol::BasicSymbolTable<Source>::validateFunctions(size_t begin, size_t end) const {
+    uint64_t size = mSource.size();
+    uint64_t nameEnd = mVersion == VERSION12 ? size : mCuTable;
+    uint64_t pcEnd = mVersion == VERSION12 ? size : mFuncTable;
+    uint64_t recordSize = mEntrySize + (mVersion == VERSION120 ? 10 : 9) * 4;
+
+    if (mVersion != VERSION12 && mCuTable > mFuncNameTable && integer(mCuTable - 1, 1) != 0)
+        return false;
+
+    for (size_t i = begin; i < end; i++) {
+        if (entry(i) > entry(i + 1))
+            return false;
+
+        uint64_t offset = mFuncData + funcOffset(i);
+
+        if (offset > size || recordSize > size - offset)
+            return false;
+
+        BasicSymbol<Source> symbol(this, offset);
+
+        // the pcdata offsets and funcdata array trail the record, sized by its npcdata and nfuncdata.
+        uint64_t arrays = symbol.trailer() + 4 + uint64_t(symbol.field(7)) * 4;
+        uint64_t funcData = integer(symbol.trailer() + 3, 1);
+
+        if (mVersion == VERSION118 || mVersion == VERSION120)
+            arrays += funcData * 4;
+        else
+            arrays = ((arrays + mPtrSize - 1) & ~uint64_t(mPtrSize - 1)) + funcData * mPtrSize;
+
+        if (arrays > size)
+            return false;
+
+        uint64_t name = mFuncNameTable + symbol.field(1);
+
+        if (name >= nameEnd || (mVersion == VERSION12 && !terminated(name, size)))
+            return false;
+
+        for (int n: {4, 5, 6}) {
+            uint32_t pcdata = symbol.field(n);
+
+            if (!pcdata)
+                continue;
+
+            std::optional<int> max = walk(mPCTable + pcdata, pcEnd);
+
+            if (!max)
+                return false;
+
+            int file = std::min<int>(*max, int(mFileNum));
+
+            if (n != 5 || file < 0)
+                continue;
+
+            if (mVersion == VERSION12) {
+                if (mFileTable + (uint64_t(file) + 1) * 4 > size)
+                    return false;
+
+                continue;
+            }
+
+            if (mCuTable + (uint64_t(symbol.field(8)) + file + 1) * 4 > mFileTable)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+template<typename Source>
+bool go::symbol::BasicSymbolTable<Source>::terminated(uint64_t offset, uint64_t end) const {
+    if (offset >= end)
+        return false;
+
+    if constexpr (Source::CONTIGUOUS) {
+        return memchr(mSource.data() + offset, 0, end - offset) != nullptr;
+    } else {
+        detail::Cursor<Source, false> cursor(mSource, offset);
+
+        while (offset < end) {
+            size_t length = std::min<uint64_t>(detail::CURSOR_BUFFER_SIZE, end - offset);
+
+            if (memchr(cursor.peek(length), 0, length))
+                return true;
+
+            cursor.skip(length);
+            offset += length;
+        }
+
+        return false;
+    }
+}
+
+template<typename Source>
+std::optional<int> go::symbol::BasicSymbolTable<Source>::walk(uint64_t offset, uint64_t end) const {
+    if (offset >= end)
+        return std::nullopt;
+
+    detail::Cursor<Source, false> cursor(mSource, offset);
+
+    int value = -1;
+    int max = -1;
+    bool first = true;
+
+    while (true) {
+        const std::byte *buffer = cursor.peek(2 * detail::MAX_VAR_INT_LENGTH);
+        std::optional<std::pair<int64_t, int>> result = binary::varInt(buffer);
+
+        if (!result || (offset += result->second) > end)
+            return std::nullopt;
+
+        if (result->first == 0 && !first)
+            return max;
+
+        std::optional<std::pair<uint64_t, int>> delta = binary::uVarInt(buffer + result->second);
+
+        if (!delta || (offset += delta->second) > end)
+            return std::nullopt;
+
+        first = false;
+        value += int(result->first);
+        max = std::max(max, value);
+
+        cursor.skip(result->second + delta->second);
+    }
+}
+
+template<typename Source>
+go::symbol::FunctionArrays go::symbol::BasicSymbolTable<Source>::functions(size_t concurrency) const {
+    FunctionArrays arrays;
+
+    arrays.entries.resize(mFuncNum);
+    arrays.ends.resize(mFuncNum);
+    arrays.nameOffsets.resize(mFuncNum);
+    arrays.startLines.resize(mFuncNum);
+    arrays.frameSizes.resize(mFuncNum);
+    arrays.funcIDs.resize(mFuncNum);
+    arrays.fileIDs.resize(mFuncNum);
+
+    // name offsets index the function name table as a whole, which is copied once instead of name by name.
+    uint64_t nameEnd = std::min<uint64_t>(mVersion == VERSION12 ? mSource.size() : mCuTable, mSource.size());
+
+    if (nameEnd > mFuncNameTable) {
+        arrays.names.resize(nameEnd - mFuncNameTable);
+
+        if (!mSource.read(mFuncNameTable, arrays.names.data(), arrays.names.size()))
+            arrays.names.clear();
+    }
+
+    if constexpr (!Source::CONCURRENT)
+        concurrency = 1;
+
+    concurrency = std::max<size_t>(1, std::min<size_t>(concurrency, mFuncNum / detail::MIN_PARALLEL_FUNCTIONS));
+
+    size_t step = (mFuncNum + concurrency - 1) / concurrency;
+    std::vector<std::thread> threads;
+
+    for (size_t i = 1; i < concurrency; i++) {
+        threads.emplace_back([=, &arrays]() {
+            functions(arrays, i * step, std::min<size_t>((i + 1) * step, mFuncNum));
+        });
+    }
+
+    functions(arrays, 0, std::min<size_t>(step, mFuncNum));
+
+    for (auto &thread: threads)
+        thread.join();
+
+    return arrays;
+}
+
+template<typename Source>
+void go::symbol::BasicSymbolTable<Source>::functions(FunctionArrays &arrays, size_t begin, size_t end) const {
+    for (size_t i = begin; i < end; i++) {
+        uint64_t entry = this->entry(i);
+        BasicSymbol<Source> symbol(this, mFuncData + funcOffset(i));
+
+        arrays.entries[i] = entry;
+        arrays.ends[i] = this->entry(i + 1);
+        arrays.nameOffsets[i] = symbol.field(1);
+
+        // go 1.20 records the line of the declaration, older tables only have the line at the entry.
+        arrays.startLines[i] = mVersion == VERSION120 ? (int32_t) symbol.field(9) : value(symbol.field(6), entry, entry);
+
+        int frame = 0;
+
+        if (uint32_t sp = symbol.field(4)) {
+            runs(sp, entry, [&](uint64_t, uint64_t, int value) {
+                frame = std::max(frame, value);
+                return true;
+            });
+        }
+
+        arrays.frameSizes[i] = frame & (mPtrSize - 1) ? 0 : frame;
+        arrays.funcIDs[i] = symbol.funcID();
+        arrays.fileIDs[i] = fileID(mVersion == VERSION12 ? 0 : symbol.field(8), value(symbol.field(5), entry, entry))
+                .value_or(UINT32_MAX);
     }
 }
 
+template<typename Source>
+uint64_t go::symbol::BasicSymbolTable<Source>::entry(size_t index) const {
+    return mBase + mConverter(mFuncTableData + index * 2 * mEntrySize, mEntrySize);
+}
+
+template<typename Source>
+uint64_t go::symbol::BasicSymbolTable<Source>::funcOffset(size_t index) const {
+    return mConverter(mFuncTableData + index * 2 * mEntrySize + mEntrySize, mEntrySize);
+}
+
+template<typename Source>
+uint64_t go::symbol::BasicSymbolTable<Source>::integer(uint64_t offset, size_t size) const {
+    if constexpr (Source::CONTIGUOUS) {
+        if (!mValidated && (offset > mSource.size() || size > mSource.size() - offset))
+            return 0;
+
+        return mConverter(mSource.data() + offset, size);
+    } else {
+        std::byte buffer[8] = {};
+
+        if (!mSource.read(offset, buffer, size))
+            return 0;
+
+        return mConverter(buffer, size);
+    }
+}
+
+template<typename Source>
+typename Source::String go::symbol::BasicSymbolTable<Source>::string(uint64_t offset) const {
+    if constexpr (Source::CONTIGUOUS) {
+        if (!mValidated && !terminated(offset, mSource.size()))
+            return "";
+
+        return (const char *) mSource.data() + offset;
+    } else {
+        std::string str;
+        detail::Cursor<Source> cursor(mSource, offset);
+
+        while (true) {
+            auto buffer = (const char *) cursor.peek(detail::CURSOR_BUFFER_SIZE);
+            size_t length = strnlen(buffer, detail::CURSOR_BUFFER_SIZE);
+
+            str.append(buffer, length);
+
+            if (length < detail::CURSOR_BUFFER_SIZE)
+                break;
+
+            cursor.skip(length);
+        }
+
+        return str;
+    }
+}
+
+template<typename Source>
+std::string_view go::symbol::BasicSymbolTable<Source>::view(uint64_t offset) const {
+    if constexpr (Source::CONTIGUOUS) {
+        return string(offset);
+    } else {
+        std::lock_guard<std::mutex> guard(mStrings->mutex);
+
+        auto it = mStrings->strings.find(offset);
+
+        if (it != mStrings->strings.end())
+            return it->second;
+
+        // node based storage keeps the interned strings in place while the table grows.
+        return mStrings->strings.emplace(offset, string(offset)).first->second;
+    }
+}
+
+template<typename Source>
+uint64_t go::symbol::BasicSymbolTable<Source>::fileOffset(uint32_t id) const {
+    if (mVersion == VERSION12)
+        return mFuncData + id;
+
+    return mFileTable + id;
+}
+
+template<typename Source>
+template<typename F>
+void go::symbol::BasicSymbolTable<Source>::runs(uint32_t offset, uint64_t entry, F &&f) const {
+    // a validated table is known to terminate every stream inside the section, others are decoded from bounded copies.
+    if (mValidated) {
+        runs(detail::Cursor<Source>(mSource, mPCTable + offset), entry, std::forward<F>(f));
+        return;
+    }
+
+    runs(detail::Cursor<Source, false>(mSource, mPCTable + offset), entry, std::forward<F>(f));
+}
+
+template<typename Source>
+template<typename Cursor, typename F>
+void go::symbol::BasicSymbolTable<Source>::runs(Cursor cursor, uint64_t entry, F &&f) const {
+    int value = -1;
+    uint64_t pc = entry;
+
+    while (true) {
+        const std::byte *buffer = cursor.peek(2 * detail::MAX_VAR_INT_LENGTH);
+        std::optional<std::pair<int64_t, int>> result = binary::varInt(buffer);
+
+        if (!result)
+            return;
+
+        if (result->first == 0 && pc != entry)
+            return;
+
+        value += int(result->first);
+        buffer += result->second;
+
+        std::optional<std::pair<uint64_t, int>> delta = binary::uVarInt(buffer);
+
+        // a pair that moves neither value nor pc never ends the stream, as happens when reading past the section.
+        if (!delta || (result->first == 0 && delta->first == 0))
+            return;
+
+        uint64_t end = pc + delta->first * mQuantum;
+        cursor.skip(result->second + delta->second);
+
+        if (!f(pc, end, value))
+            return;
+
+        pc = end;
+    }
+}
+
+template<typename Source>
+int go::symbol::BasicSymbolTable<Source>::value(uint32_t offset, uint64_t entry, uint64_t target) const {
+    int value = -1;
+
+    runs(offset, entry, [&](uint64_t, uint64_t end, int v) {
+        if (target >= end)
+            return true;
+
+        value = v;
+        return false;
+    });
+
+    return value;
+}
+
+template<typename Source>
+std::optional<uint32_t> go::symbol::BasicSymbolTable<Source>::fileID(uint32_t cu, int n) const {
+    if (n < 0 || (uint32_t) n > mFileNum)
+        return std::nullopt;
+
+    if (mVersion == VERSION12) {
+        if (n == 0)
+            return std::nullopt;
+
+        return integer(mFileTable + n * 4, 4);
+    }
+
+    auto offset = (uint32_t) integer(mCuTable + (uint64_t(cu) + n) * 4, 4);
+
+    // offset 0 is the first name of filetab, only ^0 marks a file missing from the unit.
+    if (offset == UINT32_MAX)
+        return std::nullopt;
+
+    return offset;
+}
+
+// the runtime renumbers funcID between releases sharing a table layout. the enums of those releases only disagree
+// on a few raw values, so names are read for functions carrying one of them until a single enum fits.
+template<typename Source>
+void go::symbol::BasicSymbolTable<Source>::resolveFuncIDs() {
+    std::vector<const FuncIDMap *> candidates = detail::funcIDMaps(mVersion);
+
+    for (size_t i = 0; i < mFuncNum && candidates.size() > 1; i++) {
+        BasicSymbol<Source> symbol(this, mFuncData + funcOffset(i));
+        uint8_t raw = symbol.rawFuncID();
+
+        if (std::all_of(candidates.begin(), candidates.end(), [&](const auto &map) {
+            return (*map)[raw] == (*candidates.front())[raw];
+        }))
+            continue;
+
+        // every special function but autogenerated wrappers has a runtime name.
+        FuncID id = detail::lookupFuncID(symbol.name()).value_or(FUNC_ID_WRAPPER);
+        std::vector<const FuncIDMap *> fits;
+
+        std::copy_if(candidates.begin(), candidates.end(), std::back_inserter(fits), [&](const auto &map) {
+            return (*map)[raw] == id;
+        });
+
+        if (!fits.empty())
+            candidates = std::move(fits);
+    }
+
+    mFuncIDs = candidates.front();
+}
+
+template<typename Source>
+go::symbol::BasicSymbol<Source>::BasicSymbol(const BasicSymbolTable<Source> *table, uint64_t offset)
+        : mOffset(offset), mTable(table) {
+
+}
+
+template<typename Source>
+uint64_t go::symbol::BasicSymbol<Source>::entry() const {
+    return mTable->mBase + mTable->integer(mOffset, mTable->mEntrySize);
+}
+
+template<typename Source>
+typename Source::String go::symbol::BasicSymbol<Source>::name() const {
+    return mTable->string(mTable->mFuncNameTable + field(1));
+}
+
+template<typename Source>
+int go::symbol::BasicSymbol<Source>::frameSize(uint64_t pc) const {
+    uint32_t sp = field(4);
+
+    if (sp == 0)
+        return 0;
+
+    int x = mTable->value(sp, entry(), pc);
+
+    if (x == -1)
+        return 0;
+
+    if (x & (mTable->mPtrSize - 1))
+        return 0;
+
+    return x;
+}
+
+template<typename Source>
+int go::symbol::BasicSymbol<Source>::sourceLine(uint64_t pc) const {
+    return mTable->value(field(6), entry(), pc);
+}
+
+template<typename Source>
+typename Source::String go::symbol::BasicSymbol<Source>::sourceFile(uint64_t pc) const {
+    std::optional<uint32_t> id = fileID(pc);
+
+    if (!id)
+        return "";
+
+    return mTable->string(mTable->fileOffset(*id));
+}
+
+template<typename Source>
+std::optional<uint32_t> go::symbol::BasicSymbol<Source>::fileID(uint64_t pc) const {
+    return mTable->fileID(mTable->mVersion == VERSION12 ? 0 : field(8), mTable->value(field(5), entry(), pc));
+}
+
+template<typename Source>
+go::symbol::FuncID go::symbol::BasicSymbol<Source>::funcID() const {
+    // the layout of _func before go 1.12 differs and cannot be told apart by magic, so fall back to names.
+    if (mTable->mVersion == VERSION12)
+        return detail::lookupFuncID(name()).value_or(FUNC_ID_NORMAL);
+
+    // a table rejected by its header never resolves an enum.
+    if (!mTable->mFuncIDs)
+        return FUNC_ID_NORMAL;
+
+    return (*mTable->mFuncIDs)[rawFuncID()];
+}
+
+template<typename Source>
+uint8_t go::symbol::BasicSymbol<Source>::flags() const {
+    if (mTable->mVersion == VERSION12)
+        return 0;
+
+    return mTable->integer(mOffset + mTable->mEntrySize + (mTable->mVersion == VERSION120 ? 9 : 8) * 4 + 1, 1);
+}
+
+template<typename Source>
+bool go::symbol::BasicSymbol<Source>::isStackTop() const {
+    return detail::isStackTopFuncID(funcID());
+}
+
+template<typename Source>
+int go::symbol::BasicSymbol<Source>::pcData(int table, uint64_t pc) const {
+    if (table < 0 || (uint32_t) table >= field(7))
+        return -1;
+
+    auto offset = (uint32_t) mTable->integer(trailer() + 4 + table * 4, 4);
+
+    if (!offset)
+        return -1;
+
+    int value = -1;
+
+    // validation does not cover pcdata streams, so they are always decoded from bounded copies.
+    mTable->runs(
+            detail::Cursor<Source, false>(mTable->mSource, mTable->mPCTable + offset),
+            entry(),
+            [&](uint64_t, uint64_t end, int v) {
+                if (pc >= end)
+                    return true;
+
+                value = v;
+                return false;
+            }
+    );
+
+    return value;
+}
+
+template<typename Source>
+std::optional<uint64_t> go::symbol::BasicSymbol<Source>::funcData(int index) const {
+    uint64_t trailer = this->trailer();
+
+    if (index < 0 || (uint64_t) index >= mTable->integer(trailer + 3, 1))
+        return std::nullopt;
+
+    // the funcdata array follows the pcdata offsets, as 32-bit offsets from go:func.* since go 1.18
+    // and as pointer aligned addresses before.
+    uint64_t offset = trailer + 4 + uint64_t(field(7)) * 4;
+
+    if (mTable->mVersion == VERSION118 || mTable->mVersion == VERSION120) {
+        auto value = (uint32_t) mTable->integer(offset + index * 4, 4);
+
+        if (value == UINT32_MAX)
+            return std::nullopt;
+
+        return value;
+    }
+
+    uint32_t ptrSize = mTable->mPtrSize;
+    offset = (offset + ptrSize - 1) & ~uint64_t(ptrSize - 1);
+
+    uint64_t value = mTable->integer(offset + index * ptrSize, ptrSize);
+
+    if (!value)
+        return std::nullopt;
+
+    return value;
+}
+
+template<typename Source>
+uint32_t go::symbol::BasicSymbol<Source>::field(int n) const {
+    return mTable->integer(mOffset + mTable->mEntrySize + (n - 1) * 4, 4);
+}
+
+template<typename Source>
+uint8_t go::symbol::BasicSymbol<Source>::rawFuncID() const {
+    return mTable->integer(mOffset + mTable->mEntrySize + (mTable->mVersion == VERSION120 ? 9 : 8) * 4, 1);
+}
+
+template<typename Source>
+uint64_t go::symbol::BasicSymbol<Source>::trailer() const {
+    // funcID, flag and nfuncdata bytes follow the fixed fields, whose count grew with cuOffset and startLine.
+    // versions before go 1.12 cannot be told apart from 1.12 by magic, so their layout is assumed to be the latter.
+    int n = mTable->mVersion == VERSION12 ? 7 : mTable->mVersion == VERSION120 ? 9 : 8;
+    return mOffset + mTable->mEntrySize + n * 4;
+}
+
+template<typename Source>
+go::symbol::BasicSymbolEntry<Source>::BasicSymbolEntry(
+        const BasicSymbolTable<Source> *table,
+        uint64_t entry,
+        uint64_t offset,
+        size_t index
+) : mIndex(index), mEntry(entry), mOffset(offset), mTable(table) {
+
+}
+
+template<typename Source>
+size_t go::symbol::BasicSymbolEntry<Source>::index() const {
+    return mIndex;
+}
+
+template<typename Source>
+uint64_t go::symbol::BasicSymbolEntry<Source>::entry() const {
+    return mEntry;
+}
+
+template<typename Source>
+go::symbol::BasicSymbol<Source> go::symbol::BasicSymbolEntry<Source>::symbol() const {
+    return {mTable, mTable->mFuncData + mOffset};
+}
+
+template<typename Source>
+go::symbol::BasicSymbolIterator<Source>::BasicSymbolIterator(const BasicSymbolTable<Source> *table, size_t index)
+        : mIndex(index), mTable(table) {
+
+}
+
+template<typename Source>
+go::symbol::BasicSymbolEntry<Source> go::symbol::BasicSymbolIterator<Source>::operator*() {
+    return mTable->operator[](mIndex);
+}
+
+template<typename Source>
+go::symbol::BasicSymbolIterator<Source> &go::symbol::BasicSymbolIterator<Source>::operator--() {
+    mIndex--;
+    return *this;
+}
+
+template<typename Source>
+go::symbol::BasicSymbolIterator<Source> &go::symbol::BasicSymbolIterator<Source>::operator++() {
+    mIndex++;
+    return *this;
+}
+
+template<typename Source>
+go::symbol::BasicSymbolIterator<Source> &go::symbol::BasicSymbolIterator<Source>::operator+=(std::ptrdiff_t offset) {
+    mIndex += offset;
+    return *this;
+}
+
+template<typename Source>
+go::symbol::BasicSymbolIterator<Source> go::symbol::BasicSymbolIterator<Source>::operator-(std::ptrdiff_t offset) {
+    return {mTable, mIndex - offset};
+}
+
+template<typename Source>
+go::symbol::BasicSymbolIterator<Source> go::symbol::BasicSymbolIterator<Source>::operator+(std::ptrdiff_t offset) {
+    return {mTable, mIndex + offset};
+}
+
+template<typename Source>
+bool go::symbol::BasicSymbolIterator<Source>::operator==(const BasicSymbolIterator &rhs) {
+    return mIndex == rhs.mIndex;
+}
+
+template<typename Source>
+bool go::symbol::BasicSymbolIterator<Source>::operator!=(const BasicSymbolIterator &rhs) {
+    return !operator==(rhs);
+}
+
+template<typename Source>
+std::ptrdiff_t go::symbol::BasicSymbolIterator<Source>::operator-(const BasicSymbolIterator &rhs) {
+    return std::ptrdiff_t(mIndex) - std::ptrdiff_t(rhs.mIndex);
+}
+
 #endif //GO_SYMBOL_SYMBOL_H
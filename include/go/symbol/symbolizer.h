@@ -0,0 +1,64 @@
+#ifndef GO_SYMBOL_SYMBOLIZER_H
+#define GO_SYMBOL_SYMBOLIZER_H
+
+#include <go/symbol/symbol.h>
+#include <deque>
+#include <future>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+
+namespace go::symbol {
+    struct Frame {
+        uint64_t pc;
+        uint64_t entry;
+        std::string name;
+        std::string file;
+        int line;
+    };
+
+    class Symbolizer {
+    public:
+        Symbolizer(std::shared_ptr<const SymbolTable> table, size_t workers, size_t capacity);
+        Symbolizer(const std::function<std::optional<seek::SymbolTable>()> &factory, size_t workers, size_t capacity);
+        Symbolizer(const Symbolizer &) = delete;
+        ~Symbolizer();
+
+    public:
+        Symbolizer &operator=(const Symbolizer &) = delete;
+
+    public:
+        std::future<std::vector<Frame>> submit(std::vector<uint64_t> pcs);
+        std::optional<std::future<std::vector<Frame>>> trySubmit(std::vector<uint64_t> pcs);
+
+    public:
+        void stop();
+
+    private:
+        struct Task {
+            std::vector<uint64_t> pcs;
+            std::promise<std::vector<Frame>> promise;
+        };
+
+        std::optional<Task> pop();
+
+        template<typename Table>
+        void run(Table &table);
+
+    private:
+        bool mStopped{false};
+        size_t mCapacity;
+        std::mutex mMutex;
+        std::deque<Task> mQueue;
+        std::condition_variable mNotEmpty;
+        std::condition_variable mNotFull;
+        std::vector<std::thread> mWorkers;
+        std::shared_ptr<const SymbolTable> mTable;
+        std::vector<seek::SymbolTable> mSeekTables;
+    };
+
+    template<typename Table>
+    std::vector<Frame> symbolize(Table &table, const std::vector<uint64_t> &pcs);
+}
+
+#endif //GO_SYMBOL_SYMBOLIZER_H
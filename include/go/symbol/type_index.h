@@ -0,0 +1,28 @@
+#ifndef GO_SYMBOL_TYPE_INDEX_H
+#define GO_SYMBOL_TYPE_INDEX_H
+
+#include <go/symbol/struct.h>
+#include <unordered_map>
+#include <vector>
+
+namespace go::symbol {
+    struct FieldOffset {
+        std::string name;
+        uint64_t offset;
+    };
+
+    // fields are decoded up front, so the index keeps nothing that reads the binary afterwards.
+    class TypeIndex {
+    public:
+        explicit TypeIndex(const StructTable &table);
+
+    public:
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] std::optional<std::vector<FieldOffset>> fields(const std::string &name) const;
+
+    private:
+        std::unordered_map<std::string, std::vector<FieldOffset>> mFields;
+    };
+}
+
+#endif //GO_SYMBOL_TYPE_INDEX_H
@@ -0,0 +1,231 @@
+#ifndef GO_SYMBOL_UNWIND_TABLE_H
+#define GO_SYMBOL_UNWIND_TABLE_H
+
+#include <go/symbol/symbol.h>
+#include <thread>
+#include <vector>
+
+namespace go::symbol {
+    enum UnwindFlag {
+        UNWIND_STACK_TOP = 1 << 0,
+        UNWIND_SP_WRITE = 1 << 1,
+        UNWIND_UNKNOWN = 1 << 2,
+        UNWIND_END = 1 << 3
+    };
+
+    enum UnwindOption {
+        NoUnwindOption = 0,
+        PadPowerOfTwo = 1 << 0
+    };
+
+    // a row covers [pc, next row's pc), the caller's sp is sp + spDelta + the return address size.
+    struct UnwindRow {
+        uint64_t pc;
+        int32_t spDelta;
+        uint32_t flags;
+    };
+
+    static_assert(sizeof(UnwindRow) == 16 && alignof(UnwindRow) == 8);
+
+    namespace detail {
+        class UnwindWriter {
+        public:
+            explicit UnwindWriter(UnwindRow *rows, std::optional<UnwindRow> previous = std::nullopt)
+                    : mRows(rows), mLast(previous.value_or(UnwindRow{})), mMerging(previous.has_value()) {
+
+            }
+
+        public:
+            void push(const UnwindRow &row) {
+                // the next row implies where this one ends, so a row repeating the last one adds nothing.
+                if (mMerging && mLast.spDelta == row.spDelta && mLast.flags == row.flags)
+                    return;
+
+                if (mRows)
+                    mRows[mCount] = row;
+
+                if (mCount == 0)
+                    mFirst = row;
+
+                mLast = row;
+                mMerging = true;
+                mCount++;
+            }
+
+        public:
+            [[nodiscard]] size_t count() const {
+                return mCount;
+            }
+
+            [[nodiscard]] const UnwindRow &first() const {
+                return mFirst;
+            }
+
+            [[nodiscard]] const UnwindRow &last() const {
+                return mLast;
+            }
+
+        private:
+            UnwindRow *mRows;
+            UnwindRow mFirst{};
+            UnwindRow mLast;
+            bool mMerging;
+            size_t mCount{0};
+        };
+    }
+
+    template<typename Source>
+    class BasicUnwindTable {
+    public:
+        explicit BasicUnwindTable(const BasicSymbolTable<Source> *table, size_t concurrency = 1);
+
+    public:
+        [[nodiscard]] size_t size(int options = NoUnwindOption) const;
+        bool write(UnwindRow *rows, size_t capacity, int options = NoUnwindOption) const;
+
+    private:
+        void collect(size_t begin, size_t end, detail::UnwindWriter &writer) const;
+
+    private:
+        size_t mStep;
+        size_t mCount{0};
+        const BasicSymbolTable<Source> *mTable;
+        std::vector<size_t> mOffsets;
+        std::vector<std::optional<UnwindRow>> mPrevious;
+    };
+
+    using UnwindTable = BasicUnwindTable<source::Memory>;
+}
+
+template<typename Source>
+go::symbol::BasicUnwindTable<Source>::BasicUnwindTable(const BasicSymbolTable<Source> *table, size_t concurrency)
+        : mTable(table) {
+    size_t size = mTable->size();
+
+    if constexpr (!Source::CONCURRENT)
+        concurrency = 1;
+
+    concurrency = std::max<size_t>(1, std::min<size_t>(concurrency, size / detail::MIN_PARALLEL_FUNCTIONS));
+    mStep = (size + concurrency - 1) / concurrency;
+
+    // rows are only counted here, so that write can place every range at its final offset in the caller's buffer.
+    std::vector<detail::UnwindWriter> writers(concurrency, detail::UnwindWriter(nullptr));
+    std::vector<std::thread> threads;
+
+    for (size_t i = 1; i < concurrency; i++) {
+        threads.emplace_back([=, &writers]() {
+            collect(i * mStep, std::min(size, (i + 1) * mStep), writers[i]);
+        });
+    }
+
+    collect(0, std::min(size, mStep), writers[0]);
+
+    for (auto &thread: threads)
+        thread.join();
+
+    std::optional<UnwindRow> previous;
+
+    // a range starting with the same row its predecessor ended with drops that row once merged.
+    for (const auto &writer: writers) {
+        mOffsets.push_back(mCount);
+        mPrevious.push_back(previous);
+
+        if (writer.count() == 0)
+            continue;
+
+        mCount += writer.count();
+
+        if (previous && previous->spDelta == writer.first().spDelta && previous->flags == writer.first().flags)
+            mCount--;
+
+        previous = writer.last();
+    }
+}
+
+template<typename Source>
+size_t go::symbol::BasicUnwindTable<Source>::size(int options) const {
+    if (!(options & PadPowerOfTwo) || mCount == 0)
+        return mCount;
+
+    size_t size = 1;
+
+    while (size < mCount)
+        size <<= 1;
+
+    return size;
+}
+
+template<typename Source>
+bool go::symbol::BasicUnwindTable<Source>::write(UnwindRow *rows, size_t capacity, int options) const {
+    size_t count = size(options);
+
+    if (capacity < count)
+        return false;
+
+    size_t size = mTable->size();
+    size_t concurrency = mOffsets.size();
+    std::vector<std::thread> threads;
+
+    for (size_t i = 1; i < concurrency; i++) {
+        threads.emplace_back([=]() {
+            detail::UnwindWriter writer(rows + mOffsets[i], mPrevious[i]);
+            collect(i * mStep, std::min(size, (i + 1) * mStep), writer);
+        });
+    }
+
+    detail::UnwindWriter writer(rows);
+    collect(0, std::min(size, mStep), writer);
+
+    for (auto &thread: threads)
+        thread.join();
+
+    // padding rows sort after every pc, so a fixed number of halvings always lands inside the table.
+    std::fill(rows + mCount, rows + count, UnwindRow{UINT64_MAX, 0, UNWIND_END});
+    return true;
+}
+
+template<typename Source>
+void go::symbol::BasicUnwindTable<Source>::collect(size_t begin, size_t end, detail::UnwindWriter &writer) const {
+    int mask = mTable->mPtrSize - 1;
+
+    for (size_t i = begin; i < end; i++) {
+        BasicSymbol<Source> symbol = (*mTable)[i].symbol();
+        uint64_t entry = symbol.entry();
+        uint64_t next = mTable->entry(i + 1);
+
+        uint32_t flags = 0;
+
+        if (symbol.isStackTop())
+            flags |= UNWIND_STACK_TOP;
+
+        if (symbol.flags() & FUNC_FLAG_SP_WRITE)
+            flags |= UNWIND_SP_WRITE;
+
+        uint64_t covered = entry;
+        uint32_t sp = symbol.field(4);
+
+        if (sp != 0) {
+            mTable->runs(sp, entry, [&](uint64_t start, uint64_t stop, int value) {
+                if (start >= next)
+                    return false;
+
+                if (value < 0 || (value & mask))
+                    writer.push({start, 0, flags | UNWIND_UNKNOWN});
+                else
+                    writer.push({start, value, flags});
+
+                covered = std::min(stop, next);
+                return true;
+            });
+        }
+
+        // alignment padding between functions, or a function without a pcsp table.
+        if (covered < next)
+            writer.push({covered, 0, UNWIND_UNKNOWN});
+    }
+
+    if (begin < end && end == mTable->size())
+        writer.push({mTable->entry(end), 0, UNWIND_END});
+}
+
+#endif //GO_SYMBOL_UNWIND_TABLE_H
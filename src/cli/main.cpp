@@ -0,0 +1,785 @@
+#include <go/symbol/reader.h>
+#include <go/symbol/batch.h>
+#include <go/symbol/server.h>
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <thread>
+#include <csignal>
+#include <getopt.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+constexpr auto INPUT_BUFFER_SIZE = 1 << 20;
+constexpr auto OUTPUT_BUFFER_SIZE = 1 << 20;
+
+constexpr auto NO_IMAGE = UINT32_MAX;
+constexpr auto UNKNOWN = "?";
+
+constexpr auto USAGE = "usage: go-symbol -e EXE [-b BASE] [-e EXE [-b BASE]...] [options]\n"
+                       "       go-symbol -s SOCKET\n"
+                       "\n"
+                       "reads one hex pc per line, optionally followed by a build id, and writes its frames.\n"
+                       "with --serve, keeps symbol tables resident for clients of go/symbol/protocol.h instead.\n"
+                       "\n"
+                       "  -e, --exe PATH       go executable, repeatable, lines with a build id pick the matching one\n"
+                       "  -b, --base ADDRESS   load address of the preceding executable\n"
+                       "  -i, --input PATH     read pcs from PATH instead of stdin\n"
+                       "  -m, --mode MODE      mmap (default) or seek\n"
+                       "  -t, --threads N      resolve each batch on N threads in mmap mode\n"
+                       "  -I, --inlines        expand inlined calls, innermost first, in mmap mode\n"
+                       "  -a, --addresses      print each pc before its frames\n"
+                       "  -j, --json           write one json object per line\n"
+                       "  -s, --serve SOCKET   serve requests on a unix socket until SIGINT or SIGTERM\n"
+                       "  -h, --help           print this message\n";
+
+namespace {
+    struct Location {
+        uint64_t entry;
+        std::string_view name;
+        std::string_view file;
+        int line;
+    };
+
+    struct Request {
+        uint64_t pc;
+        uint32_t image;
+        bool valid;
+        std::string_view token;
+    };
+
+    class Backend {
+    public:
+        virtual ~Backend() = default;
+
+    public:
+        // pcs are sorted and unique, the frames of pcs[i] are locations[offsets[i], offsets[i + 1]).
+        virtual void resolve(
+                const std::vector<uint64_t> &pcs,
+                std::vector<uint32_t> &offsets,
+                std::vector<Location> &locations
+        ) = 0;
+    };
+
+    class MappedBackend : public Backend {
+    public:
+        MappedBackend(go::symbol::SymbolTable table, std::optional<go::symbol::InlineUnwinder> unwinder, size_t threads)
+                : mThreads(std::max<size_t>(threads, 1)), mTable(std::move(table)), mUnwinder(std::move(unwinder)) {
+
+        }
+
+    public:
+        void resolve(
+                const std::vector<uint64_t> &pcs,
+                std::vector<uint32_t> &offsets,
+                std::vector<Location> &locations
+        ) override {
+            offsets.clear();
+            locations.clear();
+
+            if (mUnwinder) {
+                mFrames.clear();
+
+                for (const auto &pc: pcs) {
+                    offsets.push_back(locations.size());
+
+                    for (auto &frame: mUnwinder->frames(pc)) {
+                        mFrames.push_back(std::move(frame));
+
+                        const go::symbol::Frame &f = mFrames.back();
+                        locations.push_back({f.entry, f.name, f.file, f.line});
+                    }
+                }
+
+                offsets.push_back(locations.size());
+                return;
+            }
+
+            // one location per pc, so every thread fills a disjoint slice in place.
+            size_t size = pcs.size();
+            size_t threads = std::max<size_t>(1, std::min<size_t>(mThreads, size / go::symbol::detail::MIN_PARALLEL_FUNCTIONS));
+            size_t step = (size + threads - 1) / threads;
+
+            locations.resize(size);
+
+            std::vector<std::thread> workers;
+
+            for (size_t i = 1; i < threads; i++) {
+                workers.emplace_back([=, &pcs, &locations]() {
+                    resolve(pcs, locations, i * step, std::min(size, (i + 1) * step));
+                });
+            }
+
+            resolve(pcs, locations, 0, std::min(size, step));
+
+            for (auto &worker: workers)
+                worker.join();
+
+            for (size_t i = 0; i <= size; i++)
+                offsets.push_back(i);
+        }
+
+    private:
+        void resolve(const std::vector<uint64_t> &pcs, std::vector<Location> &locations, size_t begin, size_t end) const {
+            if (mTable.size() == 0) {
+                std::fill(locations.begin() + begin, locations.begin() + end, Location{0, {}, {}, -1});
+                return;
+            }
+
+            uint64_t lowest = mTable[0].entry();
+            uint64_t highest = mTable[mTable.size()].entry();
+
+            auto cursor = mTable.begin();
+
+            // names and files are views into the mapped section, nothing is copied per pc.
+            for (size_t i = begin; i < end; i++) {
+                uint64_t pc = pcs[i];
+
+                if (pc < lowest || pc >= highest) {
+                    locations[i] = {0, {}, {}, -1};
+                    continue;
+                }
+
+                cursor = std::upper_bound(cursor, mTable.end() + 1, pc, [](uint64_t value, const auto &entry) {
+                    return value < entry.entry();
+                }) - 1;
+
+                go::symbol::SymbolEntry entry = *cursor;
+                go::symbol::Symbol symbol = entry.symbol();
+
+                locations[i] = {
+                        entry.entry(),
+                        mTable.functionName(entry.index()),
+                        symbol.sourceFile(pc),
+                        symbol.sourceLine(pc)
+                };
+            }
+        }
+
+    private:
+        size_t mThreads;
+        go::symbol::SymbolTable mTable;
+        std::deque<go::symbol::Frame> mFrames;
+        std::optional<go::symbol::InlineUnwinder> mUnwinder;
+    };
+
+    class SeekBackend : public Backend {
+    public:
+        explicit SeekBackend(std::shared_ptr<const go::symbol::BasicSymbolTable<go::symbol::source::File>> table)
+                : mSymbolizer(std::move(table)) {
+
+        }
+
+    public:
+        void resolve(
+                const std::vector<uint64_t> &pcs,
+                std::vector<uint32_t> &offsets,
+                std::vector<Location> &locations
+        ) override {
+            offsets.clear();
+            locations.clear();
+
+            mFrames = mSymbolizer.symbolize(pcs);
+
+            for (const auto &frame: mFrames) {
+                offsets.push_back(locations.size());
+                locations.push_back({frame.entry, frame.name, frame.file, frame.line});
+            }
+
+            offsets.push_back(locations.size());
+        }
+
+    private:
+        std::vector<go::symbol::Frame> mFrames;
+        go::symbol::BatchSymbolizer mSymbolizer;
+    };
+
+    struct Image {
+        std::string path;
+        uint64_t base;
+        bool rebased;
+        uint64_t bias;
+        std::string buildID;
+        std::unique_ptr<Backend> backend;
+        std::vector<uint64_t> pcs;
+        std::vector<uint32_t> offsets;
+        std::vector<Location> locations;
+    };
+
+    class Output {
+    public:
+        explicit Output(int fd) : mFD(fd), mBuffer(std::make_unique<char[]>(OUTPUT_BUFFER_SIZE)) {
+
+        }
+
+        Output(const Output &) = delete;
+
+        ~Output() {
+            flush();
+        }
+
+    public:
+        Output &operator=(const Output &) = delete;
+
+    public:
+        void write(std::string_view data) {
+            if (mSize + data.size() > OUTPUT_BUFFER_SIZE) {
+                flush();
+
+                if (data.size() > OUTPUT_BUFFER_SIZE) {
+                    drain(data.data(), data.size());
+                    return;
+                }
+            }
+
+            memcpy(mBuffer.get() + mSize, data.data(), data.size());
+            mSize += data.size();
+        }
+
+        void put(char c) {
+            if (mSize == OUTPUT_BUFFER_SIZE)
+                flush();
+
+            mBuffer[mSize++] = c;
+        }
+
+        void hex(uint64_t value) {
+            char digits[18];
+            char *p = digits + sizeof(digits);
+
+            do {
+                *--p = "0123456789abcdef"[value & 0xf];
+                value >>= 4;
+            } while (value);
+
+            *--p = 'x';
+            *--p = '0';
+
+            write({p, size_t(digits + sizeof(digits) - p)});
+        }
+
+        void number(int64_t value) {
+            char digits[20];
+            char *p = digits + sizeof(digits);
+
+            uint64_t magnitude = value < 0 ? -uint64_t(value) : value;
+
+            do {
+                *--p = char('0' + magnitude % 10);
+                magnitude /= 10;
+            } while (magnitude);
+
+            if (value < 0)
+                *--p = '-';
+
+            write({p, size_t(digits + sizeof(digits) - p)});
+        }
+
+        void quoted(std::string_view str) {
+            put('"');
+
+            size_t begin = 0;
+
+            for (size_t i = 0; i < str.size(); i++) {
+                auto c = (unsigned char) str[i];
+
+                if (c != '"' && c != '\\' && c >= 0x20)
+                    continue;
+
+                write(str.substr(begin, i - begin));
+
+                if (c == '"' || c == '\\') {
+                    put('\\');
+                    put((char) c);
+                } else {
+                    write("\\u00");
+                    put("0123456789abcdef"[c >> 4]);
+                    put("0123456789abcdef"[c & 0xf]);
+                }
+
+                begin = i + 1;
+            }
+
+            write(str.substr(begin));
+            put('"');
+        }
+
+        bool flush() {
+            bool ok = drain(mBuffer.get(), mSize);
+            mSize = 0;
+            return ok;
+        }
+
+    private:
+        bool drain(const char *data, size_t size) {
+            while (size > 0) {
+                ssize_t n = ::write(mFD, data, size);
+
+                if (n < 0) {
+                    if (errno == EINTR)
+                        continue;
+
+                    if (!mFailed)
+                        fprintf(stderr, "write output failed: %s\n", strerror(errno));
+
+                    mFailed = true;
+                    return false;
+                }
+
+                data += n;
+                size -= n;
+            }
+
+            return true;
+        }
+
+    private:
+        int mFD;
+        size_t mSize{0};
+        bool mFailed{false};
+        std::unique_ptr<char[]> mBuffer;
+    };
+}
+
+static go::symbol::Server *server = nullptr;
+
+static void onSignal(int) {
+    server->stop();
+}
+
+static int serve(const char *path) {
+    go::symbol::Server daemon(path);
+
+    if (!daemon.listen()) {
+        fprintf(stderr, "listen on %s failed\n", path);
+        return EXIT_FAILURE;
+    }
+
+    server = &daemon;
+
+    struct sigaction action = {};
+    action.sa_handler = onSignal;
+
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    daemon.serve();
+    return EXIT_SUCCESS;
+}
+
+static std::optional<uint64_t> parseHex(std::string_view token) {
+    if (token.size() > 2 && token[0] == '0' && (token[1] == 'x' || token[1] == 'X'))
+        token.remove_prefix(2);
+
+    if (token.empty() || token.size() > 16)
+        return std::nullopt;
+
+    uint64_t value = 0;
+
+    for (const auto &c: token) {
+        int digit;
+
+        if (c >= '0' && c <= '9')
+            digit = c - '0';
+        else if (c >= 'a' && c <= 'f')
+            digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+            digit = c - 'A' + 10;
+        else
+            return std::nullopt;
+
+        value = value << 4 | digit;
+    }
+
+    return value;
+}
+
+static std::string_view nextToken(std::string_view &line) {
+    size_t begin = line.find_first_not_of(" \t\r");
+
+    if (begin == std::string_view::npos) {
+        line = {};
+        return {};
+    }
+
+    size_t end = line.find_first_of(" \t\r", begin);
+    std::string_view token = line.substr(begin, end == std::string_view::npos ? std::string_view::npos : end - begin);
+
+    line.remove_prefix(end == std::string_view::npos ? line.size() : end);
+    return token;
+}
+
+static bool load(Image &image, bool seek, bool inlines, size_t threads) {
+    std::optional<go::symbol::Reader> reader = go::symbol::openFile(image.path);
+
+    if (!reader) {
+        fprintf(stderr, "open %s failed\n", image.path.c_str());
+        return false;
+    }
+
+    // tables are built at link addresses, pcs are moved there by the bias of their load base.
+    // an image without a known base cannot be rebased, so its pcs are taken as link addresses.
+    std::optional<uint64_t> linked = reader->imageBase();
+    uint64_t imageBase = linked.value_or(0);
+
+    image.bias = image.rebased && linked ? image.base - imageBase : 0;
+    image.buildID = reader->buildID().value_or("");
+
+    if (seek) {
+        std::optional<go::symbol::BasicSymbolTable<go::symbol::source::File>> table = reader->fileSymbols(imageBase);
+
+        if (!table) {
+            fprintf(stderr, "load symbol table of %s failed\n", image.path.c_str());
+            return false;
+        }
+
+        image.backend = std::make_unique<SeekBackend>(
+                std::make_shared<const go::symbol::BasicSymbolTable<go::symbol::source::File>>(std::move(*table))
+        );
+
+        return true;
+    }
+
+    std::optional<go::symbol::SymbolTable> table = reader->symbols(
+            go::symbol::FileMapping,
+            0,
+            go::symbol::NoHint,
+            go::symbol::QueryAll,
+            threads
+    );
+
+    if (!table) {
+        fprintf(stderr, "load symbol table of %s failed\n", image.path.c_str());
+        return false;
+    }
+
+    std::optional<go::symbol::InlineUnwinder> unwinder;
+
+    if (inlines) {
+        unwinder = reader->inlineUnwinder(imageBase);
+
+        if (!unwinder) {
+            fprintf(stderr, "load inline trees of %s failed\n", image.path.c_str());
+            return false;
+        }
+    }
+
+    image.backend = std::make_unique<MappedBackend>(std::move(*table), std::move(unwinder), threads);
+    return true;
+}
+
+static bool unknown(const Location *begin, const Location *end) {
+    return begin == end || (begin->line < 0 && begin->name.empty());
+}
+
+static void writeText(Output &output, const Request &request, const Location *begin, const Location *end, bool addresses) {
+    if (addresses) {
+        if (request.valid)
+            output.hex(request.pc);
+        else
+            output.write(request.token);
+
+        output.put('\n');
+    }
+
+    if (unknown(begin, end)) {
+        output.write("?\n?:0\n");
+        return;
+    }
+
+    for (const Location *location = begin; location != end; location++) {
+        // positions are printed raw like go tool addr2line, which keeps lines of functions without them negative.
+        output.write(location->name.empty() ? UNKNOWN : location->name);
+        output.put('\n');
+        output.write(location->file);
+        output.put(':');
+        output.number(location->line);
+        output.put('\n');
+    }
+}
+
+static void writeJSON(Output &output, const Request &request, const Location *begin, const Location *end) {
+    output.write("{\"pc\":");
+
+    if (request.valid) {
+        output.put('"');
+        output.hex(request.pc);
+        output.put('"');
+    } else {
+        output.quoted(request.token);
+    }
+
+    output.write(",\"frames\":[");
+
+    if (unknown(begin, end)) {
+        output.write("]}\n");
+        return;
+    }
+
+    for (const Location *location = begin; location != end; location++) {
+        if (location != begin)
+            output.put(',');
+
+        output.write("{\"function\":");
+        output.quoted(location->name);
+        output.write(",\"entry\":\"");
+        output.hex(location->entry);
+        output.write("\",\"file\":");
+        output.quoted(location->file);
+        output.write(",\"line\":");
+        output.number(location->line);
+        output.put('}');
+    }
+
+    output.write("]}\n");
+}
+
+static void process(
+        std::vector<Image> &images,
+        const std::unordered_map<std::string_view, uint32_t> &ids,
+        std::string_view chunk,
+        std::vector<Request> &requests,
+        Output &output,
+        bool addresses,
+        bool json
+) {
+    requests.clear();
+
+    for (auto &image: images)
+        image.pcs.clear();
+
+    // lines are parsed in place, every token stays a view into the input buffer until the batch is written.
+    while (!chunk.empty()) {
+        size_t n = chunk.find('\n');
+        std::string_view line = chunk.substr(0, n);
+
+        chunk.remove_prefix(n == std::string_view::npos ? chunk.size() : n + 1);
+
+        std::string_view token = nextToken(line);
+
+        if (token.empty())
+            continue;
+
+        std::optional<uint64_t> pc = parseHex(token);
+        std::string_view id = nextToken(line);
+
+        uint32_t index = 0;
+
+        if (!id.empty()) {
+            auto it = ids.find(id);
+            index = it == ids.end() ? NO_IMAGE : it->second;
+        }
+
+        if (!pc || index == NO_IMAGE) {
+            requests.push_back({pc.value_or(0), NO_IMAGE, pc.has_value(), token});
+            continue;
+        }
+
+        Image &image = images[index];
+
+        requests.push_back({*pc, index, true, token});
+        image.pcs.push_back(*pc - image.bias);
+    }
+
+    for (auto &image: images) {
+        if (image.pcs.empty())
+            continue;
+
+        std::sort(image.pcs.begin(), image.pcs.end());
+        image.pcs.erase(std::unique(image.pcs.begin(), image.pcs.end()), image.pcs.end());
+
+        image.backend->resolve(image.pcs, image.offsets, image.locations);
+    }
+
+    for (const auto &request: requests) {
+        const Location *begin = nullptr;
+        const Location *end = nullptr;
+
+        if (request.image != NO_IMAGE) {
+            const Image &image = images[request.image];
+            size_t i = std::lower_bound(image.pcs.begin(), image.pcs.end(), request.pc - image.bias) - image.pcs.begin();
+
+            begin = image.locations.data() + image.offsets[i];
+            end = image.locations.data() + image.offsets[i + 1];
+        }
+
+        if (json)
+            writeJSON(output, request, begin, end);
+        else
+            writeText(output, request, begin, end, addresses);
+    }
+
+    // readers waiting on a reply to each batch, as interactive pipelines do, must not wait for the buffer to fill.
+    output.flush();
+}
+
+int main(int argc, char **argv) {
+    const option options[] = {
+            {"exe",       required_argument, nullptr, 'e'},
+            {"base",      required_argument, nullptr, 'b'},
+            {"input",     required_argument, nullptr, 'i'},
+            {"mode",      required_argument, nullptr, 'm'},
+            {"threads",   required_argument, nullptr, 't'},
+            {"inlines",   no_argument,       nullptr, 'I'},
+            {"addresses", no_argument,       nullptr, 'a'},
+            {"json",      no_argument,       nullptr, 'j'},
+            {"serve",     required_argument, nullptr, 's'},
+            {"help",      no_argument,       nullptr, 'h'},
+            {nullptr,     0,                 nullptr, 0}
+    };
+
+    std::vector<Image> images;
+    const char *input = nullptr;
+    const char *socket = nullptr;
+
+    bool seek = false;
+    bool inlines = false;
+    bool addresses = false;
+    bool json = false;
+    size_t threads = 1;
+
+    int c;
+
+    while ((c = getopt_long(argc, argv, "e:b:i:m:t:Iajs:h", options, nullptr)) != -1) {
+        switch (c) {
+            case 'e':
+                images.push_back({optarg});
+                break;
+
+            case 'b': {
+                std::optional<uint64_t> base = parseHex(optarg);
+
+                if (images.empty() || !base) {
+                    fprintf(stderr, "--base takes a hex address and follows the executable it applies to\n");
+                    return EXIT_FAILURE;
+                }
+
+                images.back().base = *base;
+                images.back().rebased = true;
+                break;
+            }
+
+            case 'i':
+                input = optarg;
+                break;
+
+            case 'm':
+                if (strcmp(optarg, "seek") == 0) {
+                    seek = true;
+                } else if (strcmp(optarg, "mmap") != 0) {
+                    fprintf(stderr, "unknown mode %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+
+                break;
+
+            case 't':
+                threads = std::max(1, atoi(optarg));
+                break;
+
+            case 'I':
+                inlines = true;
+                break;
+
+            case 'a':
+                addresses = true;
+                break;
+
+            case 'j':
+                json = true;
+                break;
+
+            case 's':
+                socket = optarg;
+                break;
+
+            case 'h':
+                fputs(USAGE, stdout);
+                return EXIT_SUCCESS;
+
+            default:
+                fputs(USAGE, stderr);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (socket)
+        return serve(socket);
+
+    if (images.empty()) {
+        fputs(USAGE, stderr);
+        return EXIT_FAILURE;
+    }
+
+    // inlined frames are decoded from funcdata outside pclntab, which only the mapped image provides.
+    if (seek && inlines) {
+        fprintf(stderr, "--inlines needs the mmap mode\n");
+        return EXIT_FAILURE;
+    }
+
+    std::unordered_map<std::string_view, uint32_t> ids;
+
+    for (size_t i = 0; i < images.size(); i++) {
+        if (!load(images[i], seek, inlines, threads))
+            return EXIT_FAILURE;
+
+        if (!images[i].buildID.empty())
+            ids.emplace(images[i].buildID, (uint32_t) i);
+    }
+
+    int fd = STDIN_FILENO;
+
+    if (input) {
+        fd = open(input, O_RDONLY | O_CLOEXEC);
+
+        if (fd < 0) {
+            fprintf(stderr, "open %s failed: %s\n", input, strerror(errno));
+            return EXIT_FAILURE;
+        }
+    }
+
+    Output output(STDOUT_FILENO);
+    std::vector<Request> requests;
+
+    // each read completes a batch of whole lines, the partial tail moves to the front for the next one.
+    std::vector<char> buffer(INPUT_BUFFER_SIZE);
+    size_t size = 0;
+
+    while (true) {
+        if (size == buffer.size())
+            buffer.resize(buffer.size() * 2);
+
+        ssize_t n = read(fd, buffer.data() + size, buffer.size() - size);
+
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+
+            fprintf(stderr, "read input failed: %s\n", strerror(errno));
+            return EXIT_FAILURE;
+        }
+
+        if (n == 0) {
+            process(images, ids, {buffer.data(), size}, requests, output, addresses, json);
+            break;
+        }
+
+        size += n;
+
+        std::string_view data(buffer.data(), size);
+        size_t last = data.rfind('\n');
+
+        if (last == std::string_view::npos)
+            continue;
+
+        process(images, ids, data.substr(0, last + 1), requests, output, addresses, json);
+
+        size -= last + 1;
+        memmove(buffer.data(), buffer.data() + last + 1, size);
+    }
+
+    if (fd != STDIN_FILENO)
+        close(fd);
+
+    return output.flush() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,182 @@
+#include <go/symbol/arg_layout.h>
+#include <go/symbol/name_index.h>
+#include <thread>
+
+constexpr auto ARG_END_SEQ = 0xff;
+constexpr auto ARG_START_AGG = 0xfe;
+constexpr auto ARG_END_AGG = 0xfd;
+constexpr auto ARG_DOT_DOT_DOT = 0xfc;
+constexpr auto ARG_OFFSET_TOO_LARGE = 0xfb;
+
+// the compiler bounds the stream at 10 components nested at most 5 deep.
+constexpr auto MAX_ARG_INFO_LENGTH = (5 * 3 + 2) * 10 + 1;
+
+// bytes of the loaded segment left from address, the stream of a function near its end can be shorter than the bound.
+static uint64_t remaining(const elf::Reader &reader, uint64_t address) {
+    for (const auto &segment: reader.segments()) {
+        if (segment->type() != PT_LOAD)
+            continue;
+
+        if (address >= segment->virtualAddress() && address - segment->virtualAddress() < segment->fileSize())
+            return segment->virtualAddress() + segment->fileSize() - address;
+    }
+
+    return 0;
+}
+
+go::symbol::ArgLayoutDecoder::ArgLayoutDecoder(
+        std::shared_ptr<const SymbolTable> table,
+        elf::Reader reader,
+        uint64_t funcData,
+        bool registerABI
+) : mRegisterABI(registerABI), mReader(std::move(reader)), mFuncData(funcData), mTable(std::move(table)) {
+
+}
+
+std::optional<go::symbol::ArgLayout> go::symbol::ArgLayoutDecoder::layout(size_t index) const {
+    if (index >= mTable->size() || mTable->version() == VERSION12)
+        return std::nullopt;
+
+    Symbol symbol = (*mTable)[index].symbol();
+    std::optional<uint64_t> info = symbol.funcData(FUNCDATA_ARG_INFO);
+
+    if (!info)
+        return std::nullopt;
+
+    uint64_t address = mFuncData + *info;
+    size_t length = std::min<uint64_t>(MAX_ARG_INFO_LENGTH, remaining(mReader, address));
+
+    if (length == 0)
+        return std::nullopt;
+
+    std::optional<std::vector<std::byte>> buffer = mReader.readVirtualMemory(address, length);
+
+    if (!buffer)
+        return std::nullopt;
+
+    const auto *data = (const uint8_t *) buffer->data();
+
+    ArgLayout layout = {};
+
+    int depth = 0;
+    int argument = -1;
+
+    for (size_t i = 0; i < length; i++) {
+        uint8_t op = data[i];
+
+        if (op == ARG_END_SEQ) {
+            locate(symbol, layout);
+            return layout;
+        }
+
+        if (op == ARG_START_AGG) {
+            if (depth++ == 0)
+                argument++;
+
+            continue;
+        }
+
+        if (op == ARG_END_AGG) {
+            depth = std::max(0, depth - 1);
+            continue;
+        }
+
+        if (op == ARG_DOT_DOT_DOT) {
+            layout.truncated = true;
+            continue;
+        }
+
+        if (depth == 0)
+            argument++;
+
+        if (op == ARG_OFFSET_TOO_LARGE) {
+            layout.truncated = true;
+            continue;
+        }
+
+        if (++i == length)
+            break;
+
+        layout.slots.push_back({uint8_t(argument), op, data[i], ARG_STACK});
+    }
+
+    return std::nullopt;
+}
+
+std::vector<std::pair<size_t, go::symbol::ArgLayout>>
+go::symbol::ArgLayoutDecoder::layouts(std::string_view pattern, size_t concurrency) const {
+    std::vector<size_t> indices = NameIndex(mTable.get()).glob(pattern);
+    std::vector<std::optional<ArgLayout>> decoded(indices.size());
+
+    size_t size = indices.size();
+    concurrency = std::max<size_t>(1, std::min<size_t>(concurrency, size / detail::MIN_PARALLEL_FUNCTIONS));
+
+    size_t step = (size + concurrency - 1) / concurrency;
+    std::vector<std::thread> threads;
+
+    auto decode = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            decoded[i] = layout(indices[i]);
+    };
+
+    for (size_t i = 1; i < concurrency; i++) {
+        threads.emplace_back([=]() {
+            decode(i * step, std::min(size, (i + 1) * step));
+        });
+    }
+
+    decode(0, std::min(size, step));
+
+    for (auto &thread: threads)
+        thread.join();
+
+    std::vector<std::pair<size_t, ArgLayout>> layouts;
+
+    for (size_t i = 0; i < size; i++) {
+        if (!decoded[i])
+            continue;
+
+        layouts.emplace_back(indices[i], std::move(*decoded[i]));
+    }
+
+    return layouts;
+}
+
+const std::shared_ptr<const go::symbol::SymbolTable> &go::symbol::ArgLayoutDecoder::table() const {
+    return mTable;
+}
+
+// the register abi lays out stack arguments first and the spill slots of register arguments after them,
+// so the start of the spill area splits the slots. argument info does not record it, it is bounded by the
+// first spill slot with tracked liveness and by any slot placed below an earlier one, which can only be
+// a stack argument following a register one. without either, where each slot lives is left unknown.
+void go::symbol::ArgLayoutDecoder::locate(const Symbol &symbol, ArgLayout &layout) const {
+    if (!mRegisterABI || (symbol.flags() & FUNC_FLAG_ASM))
+        return;
+
+    unsigned int spill = UINT8_MAX + 1;
+
+    if (std::optional<uint64_t> live = symbol.funcData(FUNCDATA_ARG_LIVE_INFO)) {
+        const std::byte *start = mReader.virtualMemory(mFuncData + *live);
+
+        if (start)
+            spill = std::to_integer<unsigned int>(*start);
+    }
+
+    for (size_t i = 0; i < layout.slots.size(); i++) {
+        for (size_t j = 0; j < i; j++) {
+            if (layout.slots[j].offset > layout.slots[i].offset)
+                spill = std::min<unsigned int>(spill, layout.slots[j].offset);
+        }
+    }
+
+    if (spill > UINT8_MAX) {
+        for (auto &slot: layout.slots)
+            slot.location = ARG_UNKNOWN;
+
+        return;
+    }
+
+    for (auto &slot: layout.slots)
+        slot.location = slot.offset >= spill ? ARG_REGISTER : ARG_STACK;
+}
@@ -0,0 +1,547 @@
+#include <go/symbol/batch.h>
+#include <zero/log.h>
+#include <algorithm>
+#include <climits>
+#include <ctime>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#include <linux/io_uring.h>
+#define GO_SYMBOL_IO_URING
+#endif
+
+constexpr auto BATCH_PAGE_SIZE = 0x1000;
+constexpr auto MAX_REQUEST_PAGES = 64;
+constexpr auto DRAIN_INTERVAL = 1000000;
+
+static bool readRequest(int fd, const go::symbol::detail::ReadRequest &request, size_t skip) {
+    std::vector<iovec> iov = request.iov;
+    auto it = iov.begin();
+    off_t offset = request.offset + (off_t) skip;
+
+    while (true) {
+        while (it != iov.end() && skip >= it->iov_len) {
+            skip -= it->iov_len;
+            ++it;
+        }
+
+        if (it == iov.end())
+            return true;
+
+        it->iov_base = (std::byte *) it->iov_base + skip;
+        it->iov_len -= skip;
+
+        ssize_t n = preadv(fd, &*it, (int) std::min<ptrdiff_t>(iov.end() - it, IOV_MAX), offset);
+
+        if (n < 0 && errno == EINTR) {
+            skip = 0;
+            continue;
+        }
+
+        if (n < 0) {
+            LOG_ERROR("preadv failed: %s", strerror(errno));
+            return false;
+        }
+
+        // the last page of a section may run past the end of the file, its remainder stays zeroed.
+        if (n == 0)
+            return true;
+
+        skip = n;
+        offset += n;
+    }
+}
+
+#ifdef GO_SYMBOL_IO_URING
+struct go::symbol::detail::ReadQueue::Ring {
+    int fd{-1};
+    unsigned int entries{};
+
+    void *sq{MAP_FAILED};
+    void *cq{MAP_FAILED};
+    size_t sqSize{};
+    size_t cqSize{};
+    io_uring_sqe *sqes{(io_uring_sqe *) MAP_FAILED};
+    size_t sqesSize{};
+
+    unsigned int *sqHead{};
+    unsigned int *sqTail{};
+    unsigned int *sqMask{};
+    unsigned int *sqArray{};
+    unsigned int *cqHead{};
+    unsigned int *cqTail{};
+    unsigned int *cqMask{};
+    io_uring_cqe *cqes{};
+
+    ~Ring() {
+        if (sqes != MAP_FAILED)
+            munmap(sqes, sqesSize);
+
+        if (cq != MAP_FAILED && cq != sq)
+            munmap(cq, cqSize);
+
+        if (sq != MAP_FAILED)
+            munmap(sq, sqSize);
+
+        if (fd >= 0)
+            close(fd);
+    }
+};
+
+go::symbol::detail::ReadQueue::ReadQueue(unsigned int depth) {
+    io_uring_params params = {};
+    int fd = (int) syscall(__NR_io_uring_setup, std::max(depth, 1u), &params);
+
+    // seccomp profiles and older kernels commonly refuse io_uring, reads then fall back to preadv.
+    if (fd < 0) {
+        LOG_WARNING("io_uring setup failed: %s", strerror(errno));
+        return;
+    }
+
+    auto ring = std::make_unique<Ring>();
+
+    ring->fd = fd;
+    ring->entries = params.sq_entries;
+    ring->sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    ring->cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        ring->sqSize = ring->cqSize = std::max(ring->sqSize, ring->cqSize);
+
+    ring->sq = mmap(nullptr, ring->sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+
+    if (ring->sq == MAP_FAILED) {
+        LOG_ERROR("map io_uring submission ring failed: %s", strerror(errno));
+        return;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        ring->cq = ring->sq;
+    else
+        ring->cq = mmap(nullptr, ring->cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+
+    if (ring->cq == MAP_FAILED) {
+        LOG_ERROR("map io_uring completion ring failed: %s", strerror(errno));
+        return;
+    }
+
+    ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    ring->sqes = (io_uring_sqe *) mmap(
+            nullptr,
+            ring->sqesSize,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            fd,
+            IORING_OFF_SQES
+    );
+
+    if (ring->sqes == MAP_FAILED) {
+        LOG_ERROR("map io_uring submission entries failed: %s", strerror(errno));
+        return;
+    }
+
+    auto sq = (std::byte *) ring->sq;
+    auto cq = (std::byte *) ring->cq;
+
+    ring->sqHead = (unsigned int *) (sq + params.sq_off.head);
+    ring->sqTail = (unsigned int *) (sq + params.sq_off.tail);
+    ring->sqMask = (unsigned int *) (sq + params.sq_off.ring_mask);
+    ring->sqArray = (unsigned int *) (sq + params.sq_off.array);
+    ring->cqHead = (unsigned int *) (cq + params.cq_off.head);
+    ring->cqTail = (unsigned int *) (cq + params.cq_off.tail);
+    ring->cqMask = (unsigned int *) (cq + params.cq_off.ring_mask);
+    ring->cqes = (io_uring_cqe *) (cq + params.cq_off.cqes);
+
+    mRing = std::move(ring);
+}
+
+bool go::symbol::detail::ReadQueue::submit(
+        int fd,
+        const std::vector<ReadRequest> &requests,
+        std::vector<bool> &completed
+) {
+    Ring &ring = *mRing;
+
+    size_t next = 0;
+    size_t done = 0;
+    unsigned int inflight = 0;
+    unsigned int unsubmitted = 0;
+
+    auto reap = [&]() {
+        unsigned int head = *ring.cqHead;
+        unsigned int end = __atomic_load_n(ring.cqTail, __ATOMIC_ACQUIRE);
+
+        while (head != end) {
+            io_uring_cqe *cqe = ring.cqes + (head & *ring.cqMask);
+            const ReadRequest &request = requests[cqe->user_data];
+
+            size_t length = 0;
+
+            for (const auto &iov: request.iov)
+                length += iov.iov_len;
+
+            // short completions are finished synchronously from where the ring left off.
+            if (cqe->res < 0 || (size_t) cqe->res < length)
+                completed[cqe->user_data] = readRequest(fd, request, std::max(cqe->res, 0));
+            else
+                completed[cqe->user_data] = true;
+
+            head++;
+            done++;
+            inflight--;
+        }
+
+        __atomic_store_n(ring.cqHead, head, __ATOMIC_RELEASE);
+    };
+
+    while (done < requests.size()) {
+        unsigned int tail = *ring.sqTail;
+
+        // every queued read has its completion slot, the completion ring is twice as deep as the submission one.
+        while (next < requests.size() && inflight < ring.entries) {
+            unsigned int slot = tail & *ring.sqMask;
+            io_uring_sqe *sqe = ring.sqes + slot;
+
+            memset(sqe, 0, sizeof(*sqe));
+
+            sqe->opcode = IORING_OP_READV;
+            sqe->fd = fd;
+            sqe->off = requests[next].offset;
+            sqe->addr = (uint64_t) requests[next].iov.data();
+            sqe->len = (uint32_t) requests[next].iov.size();
+            sqe->user_data = next;
+
+            ring.sqArray[slot] = slot;
+
+            tail++;
+            next++;
+            inflight++;
+            unsubmitted++;
+        }
+
+        __atomic_store_n(ring.sqTail, tail, __ATOMIC_RELEASE);
+
+        int n = (int) syscall(__NR_io_uring_enter, ring.fd, unsubmitted, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+
+        if (n < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+                continue;
+
+            LOG_ERROR("io_uring enter failed: %s", strerror(errno));
+
+            // reads the kernel has taken still write into the caller's buffers, so the ring is only given up once
+            // they complete. waiting is retried as a sleep, which also runs completions deferred to this task.
+            unsigned int pending = inflight - (tail - __atomic_load_n(ring.sqHead, __ATOMIC_ACQUIRE));
+
+            while (pending > 0) {
+                unsigned int before = inflight;
+
+                if (syscall(__NR_io_uring_enter, ring.fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0) {
+                    timespec delay = {0, DRAIN_INTERVAL};
+                    nanosleep(&delay, nullptr);
+                }
+
+                reap();
+                pending -= std::min(pending, before - inflight);
+            }
+
+            return false;
+        }
+
+        unsubmitted -= std::min<unsigned int>(n, unsubmitted);
+        reap();
+    }
+
+    return true;
+}
+#else
+struct go::symbol::detail::ReadQueue::Ring {
+
+};
+
+go::symbol::detail::ReadQueue::ReadQueue(unsigned int depth) {
+
+}
+
+bool go::symbol::detail::ReadQueue::submit(int, const std::vector<ReadRequest> &, std::vector<bool> &) {
+    return false;
+}
+#endif
+
+go::symbol::detail::ReadQueue::~ReadQueue() = default;
+
+bool go::symbol::detail::ReadQueue::read(int fd, const std::vector<ReadRequest> &requests) {
+    std::vector<bool> completed(requests.size());
+
+    // a ring that failed to enter is given up once its reads in flight have drained.
+    if (mRing && !submit(fd, requests, completed))
+        mRing.reset();
+
+    for (size_t i = 0; i < requests.size(); i++) {
+        if (!completed[i] && !readRequest(fd, requests[i], 0))
+            return false;
+    }
+
+    return true;
+}
+
+go::symbol::detail::Prefetched::Prefetched(const source::File &file) : mFile(file) {
+
+}
+
+size_t go::symbol::detail::Prefetched::size() const {
+    return mFile.size();
+}
+
+bool go::symbol::detail::Prefetched::read(uint64_t offset, void *buffer, size_t length) const {
+    while (length > 0) {
+        uint64_t page = offset / BATCH_PAGE_SIZE;
+        size_t n = std::min<size_t>(length, BATCH_PAGE_SIZE - offset % BATCH_PAGE_SIZE);
+
+        auto it = mPages.find(page);
+
+        // a stream running past what its wave fetched continues with plain reads.
+        if (it != mPages.end())
+            memcpy(buffer, it->second.get() + offset % BATCH_PAGE_SIZE, n);
+        else if (!mFile.read(offset, buffer, n))
+            return false;
+
+        buffer = (std::byte *) buffer + n;
+        offset += n;
+        length -= n;
+    }
+
+    return true;
+}
+
+void go::symbol::detail::Prefetched::want(uint64_t offset, size_t length) {
+    if (offset >= mFile.size() || length == 0)
+        return;
+
+    uint64_t end = std::min<uint64_t>(offset + length, mFile.size());
+
+    for (uint64_t page = offset / BATCH_PAGE_SIZE; page <= (end - 1) / BATCH_PAGE_SIZE; page++) {
+        if (mPages.find(page) == mPages.end())
+            mWanted.push_back(page);
+    }
+}
+
+bool go::symbol::detail::Prefetched::fetch(ReadQueue &queue) {
+    std::sort(mWanted.begin(), mWanted.end());
+    mWanted.erase(std::unique(mWanted.begin(), mWanted.end()), mWanted.end());
+
+    std::vector<ReadRequest> requests;
+
+    // adjacent pages are scattered into their own buffers by a single vectored read.
+    for (size_t i = 0; i < mWanted.size(); i++) {
+        uint64_t page = mWanted[i];
+        auto &buffer = mPages[page];
+
+        buffer = std::make_unique<std::byte[]>(BATCH_PAGE_SIZE);
+
+        if (i == 0 || mWanted[i - 1] + 1 != page || requests.back().iov.size() >= MAX_REQUEST_PAGES)
+            requests.push_back({mFile.offset() + (off_t) (page * BATCH_PAGE_SIZE), {}});
+
+        requests.back().iov.push_back({buffer.get(), BATCH_PAGE_SIZE});
+    }
+
+    std::vector<uint64_t> wave = std::move(mWanted);
+    mWanted.clear();
+
+    if (queue.read(mFile.fd(), requests))
+        return true;
+
+    // pages of a failed wave are dropped, so that later reads of them go to the file again.
+    for (const auto &page: wave)
+        mPages.erase(page);
+
+    return false;
+}
+
+go::symbol::BatchSymbolizer::BatchSymbolizer(
+        std::shared_ptr<const BasicSymbolTable<source::File>> table,
+        unsigned int depth
+) : mQueue(depth), mTable(std::move(table)) {
+
+}
+
+std::vector<go::symbol::Frame> go::symbol::BatchSymbolizer::symbolize(const std::vector<uint64_t> &pcs) {
+    struct Function {
+        uint64_t entry;
+        uint64_t offset;
+        uint32_t name;
+        uint32_t pcfile;
+        uint32_t pcln;
+        uint32_t cu;
+        std::string symbol;
+    };
+
+    struct Lookup {
+        size_t function;
+        std::optional<uint64_t> slot;
+        std::optional<uint32_t> file;
+    };
+
+    std::vector<uint64_t> addresses = pcs;
+
+    std::sort(addresses.begin(), addresses.end());
+    addresses.erase(std::unique(addresses.begin(), addresses.end()), addresses.end());
+
+    const BasicSymbolTable<source::File> &table = *mTable;
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    detail::Prefetched pages(table.mSource);
+
+    auto integer = [&](uint64_t offset) -> uint32_t {
+        std::byte buffer[4] = {};
+
+        if (!pages.read(offset, buffer, sizeof(buffer)))
+            return 0;
+
+        return table.mConverter(buffer, sizeof(buffer));
+    };
+
+    auto value = [&](uint32_t offset, uint64_t entry, uint64_t target) {
+        int result = -1;
+
+        table.runs(
+                detail::Cursor<detail::Prefetched, false>(pages, table.mPCTable + offset),
+                entry,
+                [&](uint64_t, uint64_t end, int v) {
+                    if (target >= end)
+                        return true;
+
+                    result = v;
+                    return false;
+                }
+        );
+
+        return result;
+    };
+
+    auto string = [&](uint64_t offset) {
+        std::string str;
+        detail::Cursor<detail::Prefetched, false> cursor(pages, offset);
+
+        while (true) {
+            auto buffer = (const char *) cursor.peek(detail::CURSOR_BUFFER_SIZE);
+            size_t length = strnlen(buffer, detail::CURSOR_BUFFER_SIZE);
+
+            str.append(buffer, length);
+
+            if (length < detail::CURSOR_BUFFER_SIZE)
+                break;
+
+            cursor.skip(length);
+        }
+
+        return str;
+    };
+
+    std::vector<Function> functions;
+    std::vector<std::optional<Lookup>> lookups(addresses.size());
+
+    // the functab is held in memory, so the first wave only needs the _func records themselves.
+    for (size_t i = 0; i < addresses.size(); i++) {
+        auto it = table.find(addresses[i]);
+
+        if (it == table.end())
+            continue;
+
+        auto entry = *it;
+
+        if (functions.empty() || functions.back().entry != entry.entry()) {
+            uint64_t offset = table.mFuncData + table.funcOffset(entry.index());
+
+            functions.push_back({entry.entry(), offset});
+            pages.want(offset, table.mEntrySize + 8 * 4);
+        }
+
+        lookups[i] = Lookup{functions.size() - 1};
+    }
+
+    pages.fetch(mQueue);
+
+    for (auto &function: functions) {
+        uint64_t fields = function.offset + table.mEntrySize;
+
+        function.name = integer(fields);
+        function.pcfile = integer(fields + 4 * 4);
+        function.pcln = integer(fields + 5 * 4);
+        function.cu = table.mVersion == VERSION12 ? 0 : integer(fields + 7 * 4);
+
+        pages.want(table.mFuncNameTable + function.name, detail::CURSOR_BUFFER_SIZE);
+        pages.want(table.mPCTable + function.pcfile, detail::CURSOR_BUFFER_SIZE);
+        pages.want(table.mPCTable + function.pcln, detail::CURSOR_BUFFER_SIZE);
+    }
+
+    pages.fetch(mQueue);
+
+    for (size_t i = 0; i < addresses.size(); i++) {
+        if (!lookups[i])
+            continue;
+
+        const Function &function = functions[lookups[i]->function];
+        int n = value(function.pcfile, function.entry, addresses[i]);
+
+        if (n < 0 || (uint32_t) n > table.mFileNum || (table.mVersion == VERSION12 && n == 0))
+            continue;
+
+        uint64_t slot = table.mVersion == VERSION12 ? table.mFileTable + n * 4 : table.mCuTable + (uint64_t(function.cu) + n) * 4;
+
+        lookups[i]->slot = slot;
+        pages.want(slot, 4);
+    }
+
+    pages.fetch(mQueue);
+
+    for (auto &lookup: lookups) {
+        if (!lookup || !lookup->slot)
+            continue;
+
+        uint32_t id = integer(*lookup->slot);
+
+        if (table.mVersion != VERSION12 && id == UINT32_MAX)
+            continue;
+
+        lookup->file = id;
+        pages.want(table.fileOffset(id), detail::CURSOR_BUFFER_SIZE);
+    }
+
+    pages.fetch(mQueue);
+
+    std::vector<Frame> frames;
+    frames.reserve(addresses.size());
+
+    for (size_t i = 0; i < addresses.size(); i++) {
+        uint64_t pc = addresses[i];
+
+        if (!lookups[i]) {
+            frames.push_back({pc, 0, {}, {}, -1});
+            continue;
+        }
+
+        Function &function = functions[lookups[i]->function];
+
+        if (function.symbol.empty())
+            function.symbol = string(table.mFuncNameTable + function.name);
+
+        frames.push_back({
+                pc,
+                function.entry,
+                function.symbol,
+                lookups[i]->file ? string(table.fileOffset(*lookups[i]->file)) : std::string(),
+                value(function.pcln, function.entry, pc)
+        });
+    }
+
+    std::vector<Frame> result;
+    result.reserve(pcs.size());
+
+    for (const auto &pc: pcs)
+        result.push_back(frames[std::lower_bound(addresses.begin(), addresses.end(), pc) - addresses.begin()]);
+
+    return result;
+}
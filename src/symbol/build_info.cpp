@@ -75,10 +75,11 @@ std::optional<go::symbol::ModuleInfo> go::symbol::BuildInfo::moduleInfo() {
     auto readEntry = [](const std::string &module) -> std::optional<Module> {
         std::vector<std::string> tokens = zero::strings::split(module, "\t");
 
-        if (tokens.size() != 4)
+        // replaced modules carry no checksum, so the last column may be missing.
+        if (tokens.size() != 3 && tokens.size() != 4)
             return std::nullopt;
 
-        return Module{tokens[1], tokens[2], tokens[3]};
+        return Module{tokens[1], tokens[2], tokens.size() == 4 ? tokens[3] : ""};
     };
 
     ModuleInfo moduleInfo;
@@ -108,7 +109,7 @@ std::optional<go::symbol::ModuleInfo> go::symbol::BuildInfo::moduleInfo() {
         } else if (zero::strings::startsWith(m, "=>")) {
             std::optional<Module> module = readEntry(m);
 
-            if (!module)
+            if (!module || moduleInfo.deps.empty())
                 continue;
 
             moduleInfo.deps.back().replace = std::make_unique<Module>(std::move(*module));
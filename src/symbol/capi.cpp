@@ -0,0 +1,218 @@
+#include <go/symbol/capi.h>
+#include <go/symbol/reader.h>
+#include <go/symbol/type_index.h>
+#include <zero/log.h>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+struct go_symbol {
+    go::symbol::Reader reader;
+    go::symbol::SymbolTable table;
+    uint64_t bias;
+    std::string buildID;
+
+    // type layouts are cached by name, including misses, so repeated queries never allocate.
+    std::mutex mutex;
+    std::optional<std::unique_ptr<go::symbol::TypeIndex>> types;
+    std::map<std::string, std::optional<std::vector<go::symbol::FieldOffset>>, std::less<>> layouts;
+};
+
+go_symbol_t *go_symbol_open(const char *path, uint64_t base) {
+    if (!path)
+        return nullptr;
+
+    // nothing may unwind into a foreign caller.
+    try {
+        std::optional<go::symbol::Reader> reader = go::symbol::openFile(path);
+
+        if (!reader)
+            return nullptr;
+
+        std::optional<go::symbol::SymbolTable> table = reader->symbols(go::symbol::FileMapping);
+
+        if (!table) {
+            LOG_ERROR("load symbol table of %s failed", path);
+            return nullptr;
+        }
+
+        std::optional<uint64_t> imageBase = reader->imageBase();
+        std::string buildID = reader->buildID().value_or("");
+
+        return new go_symbol{
+                std::move(*reader),
+                std::move(*table),
+                imageBase ? base - *imageBase : 0,
+                std::move(buildID)
+        };
+    } catch (const std::exception &e) {
+        LOG_ERROR("open %s failed: %s", path, e.what());
+        return nullptr;
+    }
+}
+
+void go_symbol_close(go_symbol_t *handle) {
+    delete handle;
+}
+
+size_t go_symbol_function_count(const go_symbol_t *handle) {
+    return handle ? handle->table.size() : 0;
+}
+
+const char *go_symbol_function_name(const go_symbol_t *handle, uint32_t function) {
+    if (!handle || function >= handle->table.size())
+        return nullptr;
+
+    return handle->table.functionName(function).data();
+}
+
+uint64_t go_symbol_function_entry(const go_symbol_t *handle, uint32_t function) {
+    if (!handle || function >= handle->table.size())
+        return 0;
+
+    return handle->table[function].entry() + handle->bias;
+}
+
+size_t go_symbol_resolve_batch(
+        const go_symbol_t *handle,
+        const uint64_t *pcs,
+        size_t count,
+        const go_symbol_frames_t *frames
+) {
+    if (!handle || !frames || (!pcs && count))
+        return 0;
+
+    // interning names and files allocates, and nothing may unwind into a foreign caller.
+    try {
+        const go::symbol::SymbolTable &table = handle->table;
+        size_t resolved = 0;
+
+        for (size_t i = 0; i < count; i++) {
+            uint64_t pc = pcs[i] - handle->bias;
+            auto it = table.find(pc);
+
+            if (it == table.end()) {
+                if (frames->entries)
+                    frames->entries[i] = 0;
+
+                if (frames->functions)
+                    frames->functions[i] = GO_SYMBOL_NONE;
+
+                if (frames->names)
+                    frames->names[i] = nullptr;
+
+                if (frames->files)
+                    frames->files[i] = nullptr;
+
+                if (frames->lines)
+                    frames->lines[i] = -1;
+
+                continue;
+            }
+
+            go::symbol::SymbolEntry entry = *it;
+            resolved++;
+
+            if (frames->entries)
+                frames->entries[i] = entry.entry() + handle->bias;
+
+            if (frames->functions)
+                frames->functions[i] = (uint32_t) entry.index();
+
+            if (frames->names)
+                frames->names[i] = table.functionName(entry.index()).data();
+
+            if (!frames->files && !frames->lines)
+                continue;
+
+            go::symbol::Symbol symbol = entry.symbol();
+
+            if (frames->files) {
+                const char *file = symbol.sourceFile(pc);
+                frames->files[i] = *file ? file : nullptr;
+            }
+
+            if (frames->lines)
+                frames->lines[i] = symbol.sourceLine(pc);
+        }
+
+        return resolved;
+    } catch (const std::exception &e) {
+        LOG_ERROR("resolve %zu addresses failed: %s", count, e.what());
+        return 0;
+    }
+}
+
+int go_symbol_type_field_offsets(
+        go_symbol_t *handle,
+        const char *type,
+        const char *const *fields,
+        size_t count,
+        uint64_t *offsets
+) {
+    if (!handle || !type || (count && (!fields || !offsets)))
+        return GO_SYMBOL_ERROR_INVALID;
+
+    std::lock_guard<std::mutex> guard(handle->mutex);
+
+    auto it = handle->layouts.find(std::string_view(type));
+
+    if (it == handle->layouts.end()) {
+        try {
+            if (!handle->types) {
+                std::optional<go::symbol::StructTable> table = handle->reader.typeLinks();
+                handle->types = table ? std::make_unique<go::symbol::TypeIndex>(std::move(*table)) : nullptr;
+            }
+
+            std::optional<std::vector<go::symbol::FieldOffset>> layout;
+
+            if (*handle->types)
+                layout = (*handle->types)->fields(type);
+
+            it = handle->layouts.emplace(type, std::move(layout)).first;
+        } catch (const std::exception &e) {
+            LOG_ERROR("load layout of %s failed: %s", type, e.what());
+            return GO_SYMBOL_ERROR_INVALID;
+        }
+    }
+
+    if (!it->second)
+        return GO_SYMBOL_ERROR_NOT_FOUND;
+
+    int found = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        offsets[i] = GO_SYMBOL_NO_OFFSET;
+
+        if (!fields[i])
+            continue;
+
+        for (const auto &field: *it->second) {
+            if (field.name != fields[i])
+                continue;
+
+            offsets[i] = field.offset;
+            found++;
+            break;
+        }
+    }
+
+    return found;
+}
+
+int go_symbol_build_id(const go_symbol_t *handle, char *buffer, size_t size) {
+    if (!handle || (!buffer && size))
+        return GO_SYMBOL_ERROR_INVALID;
+
+    if (handle->buildID.empty())
+        return GO_SYMBOL_ERROR_NOT_FOUND;
+
+    if (size) {
+        size_t n = std::min(size - 1, handle->buildID.size());
+
+        memcpy(buffer, handle->buildID.data(), n);
+        buffer[n] = '\0';
+    }
+
+    return (int) handle->buildID.size();
+}
@@ -0,0 +1,226 @@
+#include <go/symbol/diff.h>
+#include <zero/log.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+constexpr auto TEXT_SECTION = ".text";
+
+constexpr auto FNV_OFFSET_BASIS = 0xcbf29ce484222325;
+constexpr auto FNV_PRIME = 0x100000001b3;
+
+constexpr const char *CHANGE_KINDS[] = {"added", "removed", "resized", "modified"};
+
+namespace {
+    struct Record {
+        uint64_t hash;
+        uint64_t size;
+        uint64_t content;
+        uint32_t index;
+    };
+
+    struct Image {
+        go::symbol::SymbolTable table;
+        std::shared_ptr<elf::ISection> text;
+        std::vector<Record> records;
+    };
+}
+
+static uint64_t fnv(const std::byte *data, size_t size) {
+    uint64_t hash = FNV_OFFSET_BASIS;
+
+    for (size_t i = 0; i < size; i++) {
+        hash ^= std::to_integer<uint64_t>(data[i]);
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+static std::optional<Image> load(go::symbol::Reader &reader, bool contents) {
+    std::optional<go::symbol::SymbolTable> table = reader.symbols(go::symbol::FileMapping);
+
+    if (!table)
+        return std::nullopt;
+
+    std::shared_ptr<elf::ISection> text;
+
+    if (contents) {
+        text = reader.section(TEXT_SECTION);
+
+        if (!text)
+            LOG_WARNING("text section not found, contents are not compared");
+    }
+
+    size_t size = table->size();
+    return Image{std::move(*table), std::move(text), std::vector<Record>(size)};
+}
+
+static void collect(Image &image, size_t begin, size_t end) {
+    const go::symbol::SymbolTable &table = image.table;
+    const std::shared_ptr<elf::ISection> &text = image.text;
+
+    for (size_t i = begin; i < end; i++) {
+        uint64_t entry = table[i].entry();
+        uint64_t size = table[i + 1].entry() - entry;
+        uint64_t content = 0;
+
+        if (text && entry >= text->address() && entry + size <= text->address() + text->size())
+            content = fnv(text->data() + (entry - text->address()), size);
+
+        image.records[i] = {std::hash<std::string_view>()(table.functionName(i)), size, content, (uint32_t) i};
+    }
+}
+
+static int compare(const Image &lhs, const Record &l, const Image &rhs, const Record &r) {
+    if (l.hash != r.hash)
+        return l.hash < r.hash ? -1 : 1;
+
+    // names are only compared when their hashes collide, or to pair up a match.
+    return lhs.table.functionName(l.index).compare(rhs.table.functionName(r.index));
+}
+
+std::optional<go::symbol::BinaryDiff>
+go::symbol::diff(Reader &before, Reader &after, int options, size_t concurrency) {
+    bool contents = options & DiffContents;
+
+    std::optional<Image> images[2] = {load(before, contents), load(after, contents)};
+
+    if (!images[0] || !images[1]) {
+        LOG_ERROR("load symbol tables failed");
+        return std::nullopt;
+    }
+
+    concurrency = std::max<size_t>(concurrency, 1);
+
+    // both functabs are cut into ranges, which a shared pool of workers drains in a single pass.
+    std::vector<std::tuple<Image *, size_t, size_t>> jobs;
+
+    for (auto &image: images) {
+        size_t size = image->records.size();
+        size_t step = std::max<size_t>(detail::MIN_PARALLEL_FUNCTIONS, (size + concurrency - 1) / concurrency);
+
+        for (size_t i = 0; i < size; i += step)
+            jobs.emplace_back(&*image, i, std::min(size, i + step));
+    }
+
+    std::atomic<size_t> next = 0;
+
+    auto work = [&]() {
+        for (size_t i = next++; i < jobs.size(); i = next++)
+            collect(*std::get<0>(jobs[i]), std::get<1>(jobs[i]), std::get<2>(jobs[i]));
+    };
+
+    std::vector<std::thread> threads;
+
+    for (size_t i = 1; i < std::min(concurrency, jobs.size()); i++)
+        threads.emplace_back(work);
+
+    work();
+
+    for (auto &thread: threads)
+        thread.join();
+
+    threads.clear();
+
+    // functions sharing a name, like the ABI wrappers of assembly functions, are paired in functab order.
+    auto sort = [](Image &image) {
+        std::sort(image.records.begin(), image.records.end(), [&](const auto &lhs, const auto &rhs) {
+            int order = compare(image, lhs, image, rhs);
+            return order < 0 || (order == 0 && lhs.index < rhs.index);
+        });
+    };
+
+    if (concurrency > 1)
+        threads.emplace_back(sort, std::ref(*images[1]));
+    else
+        sort(*images[1]);
+
+    sort(*images[0]);
+
+    for (auto &thread: threads)
+        thread.join();
+
+    const Image &old = *images[0];
+    const Image &now = *images[1];
+
+    BinaryDiff result = {};
+
+    auto i = old.records.begin();
+    auto j = now.records.begin();
+
+    while (i != old.records.end() || j != now.records.end()) {
+        int order = i == old.records.end() ? 1 : j == now.records.end() ? -1 : compare(old, *i, now, *j);
+
+        if (order < 0) {
+            result.changes.push_back({FUNCTION_REMOVED, std::string(old.table.functionName(i->index)), i->size, 0});
+            ++i;
+            continue;
+        }
+
+        if (order > 0) {
+            result.changes.push_back({FUNCTION_ADDED, std::string(now.table.functionName(j->index)), 0, j->size});
+            ++j;
+            continue;
+        }
+
+        if (i->size != j->size)
+            result.changes.push_back({
+                    FUNCTION_RESIZED,
+                    std::string(now.table.functionName(j->index)),
+                    i->size,
+                    j->size
+            });
+        else if (contents && i->content != j->content)
+            result.changes.push_back({
+                    FUNCTION_MODIFIED,
+                    std::string(now.table.functionName(j->index)),
+                    i->size,
+                    j->size
+            });
+        else
+            result.unchanged++;
+
+        ++i;
+        ++j;
+    }
+
+    std::sort(result.changes.begin(), result.changes.end(), [](const auto &lhs, const auto &rhs) {
+        return std::tie(lhs.kind, lhs.name) < std::tie(rhs.kind, rhs.name);
+    });
+
+    return result;
+}
+
+std::string go::symbol::toJSON(const BinaryDiff &diff) {
+    std::string json = "{\"unchanged\":" + std::to_string(diff.unchanged) + ",\"changes\":[";
+
+    for (size_t i = 0; i < diff.changes.size(); i++) {
+        const FunctionChange &change = diff.changes[i];
+
+        if (i > 0)
+            json += ",";
+
+        json += "{\"kind\":\"";
+        json += CHANGE_KINDS[change.kind];
+        json += "\",\"name\":\"";
+
+        for (const auto &c: change.name) {
+            if (c == '"' || c == '\\') {
+                json += '\\';
+                json += c;
+            } else if ((unsigned char) c < 0x20) {
+                char escaped[7];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                json += escaped;
+            } else {
+                json += c;
+            }
+        }
+
+        json += "\",\"before\":" + std::to_string(change.before) + ",\"after\":" + std::to_string(change.after) + "}";
+    }
+
+    json += "]}";
+    return json;
+}
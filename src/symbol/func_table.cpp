@@ -0,0 +1,166 @@
+#include <go/symbol/func_table.h>
+#include <zero/log.h>
+#include <algorithm>
+
+constexpr auto BLOCK_SIZE = 64;
+
+go::symbol::CompactFuncTable::CompactFuncTable(const SymbolTable &source, std::shared_ptr<const SymbolTable> table)
+        : mTable(std::move(table)) {
+    size_t size = source.size();
+
+    // a table rejected by its header has no functions, and nothing to read an entry from.
+    if (size == 0)
+        return;
+
+    uint64_t base = source[0].entry();
+    uint64_t text = source.entry(size) - base;
+
+    if (text > UINT32_MAX) {
+        LOG_ERROR("text size %llu exceeds 32-bit offsets", (unsigned long long) text);
+        return;
+    }
+
+    std::vector<uint32_t> entries;
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> skipIndex;
+
+    // entries are stored as 32-bit offsets from the first function, the trailing one being the end of text.
+    entries.reserve(size + 1);
+    offsets.reserve(size);
+    skipIndex.reserve((size + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+    for (size_t i = 0; i <= size; i++) {
+        uint64_t offset = source.entry(i) - base;
+
+        // an entry below the first one wraps around and lands here as well.
+        if (offset > text) {
+            LOG_ERROR("function %zu lies outside the text", i);
+            return;
+        }
+
+        if (i % BLOCK_SIZE == 0 && i < size)
+            skipIndex.push_back(offset);
+
+        entries.push_back(offset);
+
+        if (i == size)
+            break;
+
+        uint64_t funcOffset = source.funcOffset(i);
+
+        if (funcOffset > UINT32_MAX) {
+            LOG_ERROR("func offset %llu exceeds 32 bits", (unsigned long long) funcOffset);
+            return;
+        }
+
+        offsets.push_back(funcOffset);
+    }
+
+    mBase = base;
+    mEntries = std::move(entries);
+    mOffsets = std::move(offsets);
+    mSkipIndex = std::move(skipIndex);
+}
+
+std::vector<std::pair<uint64_t, uint64_t>>
+go::symbol::CompactFuncTable::regions(const SymbolTable &table, int queries) {
+    uint64_t begin = table.mFuncTable;
+    uint64_t end = begin + (table.mFuncNum + 1) * 2 * table.mEntrySize;
+
+    std::vector<std::pair<uint64_t, uint64_t>> regions;
+
+    // the regions of the queries, with the functab cut out of whichever of them spans it.
+    for (const auto &[first, last]: table.regions(queries)) {
+        if (last <= begin || first >= end) {
+            regions.emplace_back(first, last);
+            continue;
+        }
+
+        if (first < begin)
+            regions.emplace_back(first, begin);
+
+        if (last > end)
+            regions.emplace_back(end, last);
+    }
+
+    return regions;
+}
+
+go::symbol::CompactFuncIterator go::symbol::CompactFuncTable::find(uint64_t address) const {
+    if (mSkipIndex.empty() || address < mBase || address - mBase >= mEntries.back())
+        return end();
+
+    auto offset = (uint32_t) (address - mBase);
+
+    // the skip index is small enough to stay in cache, so only one block of entries is touched per lookup.
+    size_t block = std::upper_bound(mSkipIndex.begin(), mSkipIndex.end(), offset) - mSkipIndex.begin() - 1;
+
+    auto first = mEntries.begin() + std::ptrdiff_t(block * BLOCK_SIZE);
+    auto last = mEntries.begin() + std::ptrdiff_t(std::min((block + 1) * BLOCK_SIZE, size()));
+
+    return {this, size_t(std::upper_bound(first, last, offset) - mEntries.begin() - 1)};
+}
+
+size_t go::symbol::CompactFuncTable::size() const {
+    return mOffsets.size();
+}
+
+size_t go::symbol::CompactFuncTable::memoryUsage() const {
+    return (mEntries.capacity() + mOffsets.capacity() + mSkipIndex.capacity()) * sizeof(uint32_t);
+}
+
+go::symbol::SymbolEntry go::symbol::CompactFuncTable::operator[](size_t index) const {
+    return {mTable.get(), mBase + mEntries[index], mOffsets[index], index};
+}
+
+go::symbol::CompactFuncIterator go::symbol::CompactFuncTable::begin() const {
+    return {this, 0};
+}
+
+go::symbol::CompactFuncIterator go::symbol::CompactFuncTable::end() const {
+    return {this, size()};
+}
+
+go::symbol::CompactFuncIterator::CompactFuncIterator(const go::symbol::CompactFuncTable *table, size_t index)
+        : mIndex(index), mTable(table) {
+
+}
+
+go::symbol::SymbolEntry go::symbol::CompactFuncIterator::operator*() {
+    return mTable->operator[](mIndex);
+}
+
+go::symbol::CompactFuncIterator &go::symbol::CompactFuncIterator::operator--() {
+    mIndex--;
+    return *this;
+}
+
+go::symbol::CompactFuncIterator &go::symbol::CompactFuncIterator::operator++() {
+    mIndex++;
+    return *this;
+}
+
+go::symbol::CompactFuncIterator &go::symbol::CompactFuncIterator::operator+=(std::ptrdiff_t offset) {
+    mIndex += offset;
+    return *this;
+}
+
+go::symbol::CompactFuncIterator go::symbol::CompactFuncIterator::operator-(std::ptrdiff_t offset) {
+    return {mTable, mIndex - offset};
+}
+
+go::symbol::CompactFuncIterator go::symbol::CompactFuncIterator::operator+(std::ptrdiff_t offset) {
+    return {mTable, mIndex + offset};
+}
+
+bool go::symbol::CompactFuncIterator::operator==(const go::symbol::CompactFuncIterator &rhs) {
+    return mIndex == rhs.mIndex;
+}
+
+bool go::symbol::CompactFuncIterator::operator!=(const go::symbol::CompactFuncIterator &rhs) {
+    return !operator==(rhs);
+}
+
+std::ptrdiff_t go::symbol::CompactFuncIterator::operator-(const go::symbol::CompactFuncIterator &rhs) {
+    return std::ptrdiff_t(mIndex) - std::ptrdiff_t(rhs.mIndex);
+}
@@ -0,0 +1,90 @@
+#include <go/symbol/function_map.h>
+#include <zero/log.h>
+
+constexpr auto MAX_BUCKET_SHIFT = 31;
+
+static int searchDepth(size_t candidates) {
+    int depth = 0;
+
+    while ((size_t{1} << depth) < candidates)
+        depth++;
+
+    return depth;
+}
+
+// each bucket holds the entry owning its first byte, the entry owning a pc is then bounded by its bucket and the next.
+static std::vector<uint32_t> bucketize(const std::vector<uint32_t> &offsets, uint32_t shift) {
+    std::vector<uint32_t> buckets((offsets.back() >> shift) + 2);
+    size_t index = 0;
+
+    for (size_t i = 0; i < buckets.size(); i++) {
+        uint64_t start = (uint64_t) i << shift;
+
+        while (index + 1 < offsets.size() && offsets[index + 1] <= start)
+            index++;
+
+        buckets[i] = index;
+    }
+
+    return buckets;
+}
+
+std::optional<go::symbol::FunctionMap>
+go::symbol::exportFunctionMap(const SymbolTable &table, size_t capacity, int depth) {
+    size_t size = table.size();
+
+    if (size == 0) {
+        LOG_ERROR("symbol table is empty");
+        return std::nullopt;
+    }
+
+    if (size + 1 > capacity) {
+        LOG_ERROR("%zu functions exceed the map capacity %zu", size, capacity);
+        return std::nullopt;
+    }
+
+    uint64_t base = table[0].entry();
+    uint64_t text = table[size].entry() - base;
+
+    if (text > UINT32_MAX) {
+        LOG_ERROR("text size %llu exceeds 32-bit offsets", (unsigned long long) text);
+        return std::nullopt;
+    }
+
+    FunctionMap map = {base, MAX_BUCKET_SHIFT, searchDepth(size + 1)};
+
+    map.offsets.reserve(size + 1);
+    map.functions.reserve(size + 1);
+
+    for (size_t i = 0; i < size; i++) {
+        map.offsets.push_back(uint32_t(table[i].entry() - base));
+        map.functions.push_back(uint32_t(i));
+    }
+
+    map.offsets.push_back(uint32_t(text));
+    map.functions.push_back(NO_FUNCTION);
+
+    // the coarsest buckets that bring every search within depth, or the finest the capacity allows.
+    for (int shift = MAX_BUCKET_SHIFT; shift >= 0; shift--) {
+        if ((text >> shift) + 2 > capacity)
+            break;
+
+        std::vector<uint32_t> buckets = bucketize(map.offsets, shift);
+        size_t widest = 0;
+
+        for (size_t i = 0; i + 1 < buckets.size(); i++)
+            widest = std::max<size_t>(widest, buckets[i + 1] - buckets[i] + 1);
+
+        map.shift = shift;
+        map.depth = searchDepth(widest);
+        map.buckets = std::move(buckets);
+
+        if (map.depth <= depth)
+            break;
+    }
+
+    if (map.depth > depth)
+        LOG_WARNING("bucket capacity %zu bounds searches at depth %d", capacity, map.depth);
+
+    return map;
+}
@@ -0,0 +1,74 @@
+#include <go/symbol/inline.h>
+
+constexpr auto MAX_INLINE_DEPTH = 256;
+
+go::symbol::InlineUnwinder::InlineUnwinder(
+        std::shared_ptr<const SymbolTable> table,
+        elf::Reader reader,
+        endian::Converter converter,
+        uint64_t funcData
+) : mReader(std::move(reader)), mFuncData(funcData), mConverter(converter), mTable(std::move(table)) {
+
+}
+
+std::vector<go::symbol::Frame> go::symbol::InlineUnwinder::frames(uint64_t pc) const {
+    auto it = mTable->find(pc);
+
+    if (it == mTable->end())
+        return {{pc, 0, {}, {}, -1}};
+
+    SymbolEntry entry = *it;
+    Symbol symbol = entry.symbol();
+
+    std::vector<Frame> frames;
+
+    // inlinedCall lost its parent, file and line fields in go 1.20, leaving name and parentPc at new offsets.
+    SymbolVersion version = mTable->version();
+    std::optional<uint64_t> tree = version == VERSION12 ? std::nullopt : symbol.funcData(FUNCDATA_INL_TREE);
+
+    size_t size = version == VERSION120 ? 16 : 20;
+    size_t name = version == VERSION120 ? 4 : 12;
+    size_t parent = version == VERSION120 ? 8 : 16;
+
+    uint64_t current = pc;
+
+    // each level reports the position of its call site, found at parentPc in the physical function.
+    while (tree && frames.size() < MAX_INLINE_DEPTH) {
+        int index = symbol.pcData(PCDATA_INL_TREE_INDEX, current);
+
+        if (index < 0)
+            break;
+
+        // go:func.* is not covered by table validation, so the record and the name it points at are checked here.
+        std::optional<std::vector<std::byte>> call = mReader.readVirtualMemory(
+                mFuncData + *tree + (uint64_t) index * size,
+                size
+        );
+
+        if (!call)
+            break;
+
+        uint64_t nameOff = mConverter(call->data() + name, 4);
+
+        if (nameOff >= mTable->mCuTable - mTable->mFuncNameTable ||
+            !mTable->terminated(mTable->mFuncNameTable + nameOff, mTable->mCuTable))
+            break;
+
+        frames.push_back({
+                pc,
+                entry.entry(),
+                std::string(mTable->view(mTable->mFuncNameTable + nameOff)),
+                symbol.sourceFile(current),
+                symbol.sourceLine(current)
+        });
+
+        current = entry.entry() + (int32_t) mConverter(call->data() + parent, 4);
+    }
+
+    frames.push_back({pc, entry.entry(), symbol.name(), symbol.sourceFile(current), symbol.sourceLine(current)});
+    return frames;
+}
+
+const std::shared_ptr<const go::symbol::SymbolTable> &go::symbol::InlineUnwinder::table() const {
+    return mTable;
+}
@@ -9,8 +9,8 @@ go::symbol::InterfaceTable::InterfaceTable(
         uint64_t base,
         size_t ptrSize,
         endian::Converter converter
-) : mReader(std::move(reader)), mSection(std::move(section)), mVersion(version), mTypes(types), mBase(base),
-    mPtrSize(ptrSize), mConverter(converter) {
+) : mBase(base), mTypes(types), mPtrSize(ptrSize), mVersion(version), mConverter(converter),
+    mReader(std::move(reader)), mSection(std::move(section)) {
         mCount = mSection->size() / mPtrSize;
         mData = mSection->data();
 }
@@ -24,8 +24,8 @@ go::symbol::InterfaceTable::InterfaceTable(
         uint64_t base,
         size_t ptrSize,
         endian::Converter converter
-) : mReader(std::move(reader)), mData(data), mCount(size), mVersion(version), mTypes(types), mBase(base),
-    mPtrSize(ptrSize) ,mConverter(converter) {
+) : mBase(base), mTypes(types), mPtrSize(ptrSize), mVersion(version), mConverter(converter),
+    mReader(std::move(reader)), mCount(size), mData(data) {
 }
 
 size_t go::symbol::InterfaceTable::size() const {
@@ -45,12 +45,12 @@ go::symbol::InterfaceIterator go::symbol::InterfaceTable::end() const {
 }
 
 go::symbol::InterfaceIterator::InterfaceIterator(const go::symbol::InterfaceTable *table, const std::byte *buffer)
-        : mTable(table), mBuffer(buffer) {
+        : mBuffer(buffer), mTable(table) {
 
 }
 
 go::symbol::Interface::Interface(const go::symbol::InterfaceTable *table, uint64_t address)
-        : mTable(table), mAddress(address) {
+        : mAddress(address), mTable(table) {
 }
 
 uint64_t go::symbol::Interface::address() const {
@@ -0,0 +1,102 @@
+#include <go/symbol/mixed.h>
+#include <algorithm>
+
+go::symbol::MixedSymbolizer::MixedSymbolizer(
+        std::shared_ptr<const SymbolTable> table,
+        std::vector<NativeSymbol> symbols
+) : mTable(std::move(table)) {
+    uint64_t lowest = 0;
+    uint64_t highest = 0;
+
+    if (mTable && mTable->size() > 0) {
+        lowest = (*mTable)[0].entry();
+        highest = (*mTable)[mTable->size()].entry();
+    }
+
+    // go functions are listed in .symtab as well, the functab stays authoritative for its own range.
+    symbols.erase(
+            std::remove_if(symbols.begin(), symbols.end(), [=](const auto &symbol) {
+                return symbol.address >= lowest && symbol.address < highest;
+            }),
+            symbols.end()
+    );
+
+    // aliases share an address, the sized one is kept so that its extent is known.
+    std::sort(symbols.begin(), symbols.end(), [](const auto &lhs, const auto &rhs) {
+        if (lhs.address != rhs.address)
+            return lhs.address < rhs.address;
+
+        return lhs.size > rhs.size;
+    });
+
+    symbols.erase(
+            std::unique(symbols.begin(), symbols.end(), [](const auto &lhs, const auto &rhs) {
+                return lhs.address == rhs.address;
+            }),
+            symbols.end()
+    );
+
+    size_t count = mTable ? mTable->size() : 0;
+    mIntervals.reserve(count + symbols.size());
+
+    for (size_t i = 0; i < count; i++)
+        mIntervals.push_back({(*mTable)[i].entry(), (*mTable)[i + 1].entry(), (uint32_t) i, false});
+
+    mNameOffsets.reserve(symbols.size());
+
+    for (size_t i = 0; i < symbols.size(); i++) {
+        const NativeSymbol &symbol = symbols[i];
+
+        // an unsized symbol, as assembly often leaves them, reaches up to whatever follows it.
+        uint64_t limit = i + 1 < symbols.size() ? symbols[i + 1].address : UINT64_MAX;
+
+        if (lowest != highest && symbol.address < lowest)
+            limit = std::min(limit, lowest);
+
+        uint64_t end = symbol.size ? std::min(symbol.address + symbol.size, limit) : limit;
+
+        if (end == UINT64_MAX)
+            end = symbol.address + 1;
+
+        mIntervals.push_back({symbol.address, end, (uint32_t) mNameOffsets.size(), true});
+        mNameOffsets.push_back((uint32_t) mNames.size());
+
+        mNames.append(symbol.name);
+        mNames.push_back('\0');
+    }
+
+    std::sort(mIntervals.begin(), mIntervals.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.begin < rhs.begin;
+    });
+}
+
+go::symbol::Frame go::symbol::MixedSymbolizer::symbolize(uint64_t pc) const {
+    auto it = std::upper_bound(mIntervals.begin(), mIntervals.end(), pc, [](uint64_t value, const auto &interval) {
+        return value < interval.begin;
+    });
+
+    if (it == mIntervals.begin() || pc >= std::prev(it)->end)
+        return {pc, 0, {}, {}, -1};
+
+    const Interval &interval = *std::prev(it);
+
+    if (interval.native)
+        return {pc, interval.begin, mNames.data() + mNameOffsets[interval.index], {}, -1};
+
+    Symbol symbol = (*mTable)[interval.index].symbol();
+    return {pc, interval.begin, symbol.name(), symbol.sourceFile(pc), symbol.sourceLine(pc)};
+}
+
+std::vector<go::symbol::Frame> go::symbol::MixedSymbolizer::symbolize(const std::vector<uint64_t> &pcs) const {
+    std::vector<Frame> frames;
+    frames.reserve(pcs.size());
+
+    for (const auto &pc: pcs)
+        frames.push_back(symbolize(pc));
+
+    return frames;
+}
+
+size_t go::symbol::MixedSymbolizer::size() const {
+    return mIntervals.size();
+}
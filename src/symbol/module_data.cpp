@@ -35,6 +35,12 @@ namespace go::symbol {
 
         }
 
+        std::optional<uint64_t> ModuleData::gofunc() const {
+            auto offsets = getOffsets(mVersion, mPtrSize);
+            if (!offsets || !offsets->gofunc) return std::nullopt; // funcdata are absolute before 1.18
+            return readUint(mReader, mAddress + offsets->gofunc, mConverter, mPtrSize);
+        }
+
         std::optional<std::pair<const std::byte*, size_t>> ModuleData::typeLinks() const {
             auto offsets = getOffsets(mVersion, mPtrSize);
             if (!offsets) return std::nullopt;
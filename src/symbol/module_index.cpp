@@ -0,0 +1,38 @@
+#include <go/symbol/module_index.h>
+
+constexpr auto HEX_DIGITS = "0123456789abcdef";
+
+std::string_view go::symbol::detail::packagePath(std::string_view name) {
+    // type arguments may hold paths of their own, only the part before them names the package.
+    name = name.substr(0, name.find('['));
+
+    size_t slash = name.rfind('/');
+    size_t dot = name.find('.', slash == std::string_view::npos ? 0 : slash + 1);
+
+    if (dot == std::string_view::npos)
+        return {};
+
+    return name.substr(0, dot);
+}
+
+std::string go::symbol::detail::symbolPrefix(std::string_view path) {
+    size_t slash = path.rfind('/');
+    std::string prefix;
+
+    // mirrors the escaping of the go linker, which keeps the separator between package and name unambiguous.
+    for (size_t i = 0; i < path.size(); i++) {
+        auto c = (unsigned char) path[i];
+
+        if (c <= ' ' || (c == '.' && (slash == std::string_view::npos || i > slash)) || c == '%' || c == '"' ||
+            c >= 0x7f) {
+            prefix.push_back('%');
+            prefix.push_back(HEX_DIGITS[c >> 4]);
+            prefix.push_back(HEX_DIGITS[c & 0xf]);
+            continue;
+        }
+
+        prefix.push_back((char) c);
+    }
+
+    return prefix;
+}
@@ -0,0 +1,70 @@
+#include <go/symbol/name_index.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+size_t go::symbol::detail::search(const char *buffer, size_t size, size_t from, std::string_view needle) {
+    size_t n = needle.size();
+
+    if (from > size || n > size - from)
+        return std::string::npos;
+
+    size_t i = from;
+
+#ifdef __SSE2__
+    // compare the first and last byte of the needle at 16 positions at once, only candidates passing both get a memcmp.
+    const __m128i first = _mm_set1_epi8(needle.front());
+    const __m128i last = _mm_set1_epi8(needle.back());
+
+    for (; i + n - 1 + 16 <= size; i += 16) {
+        __m128i head = _mm_loadu_si128((const __m128i *) (buffer + i));
+        __m128i tail = _mm_loadu_si128((const __m128i *) (buffer + i + n - 1));
+
+        auto mask = (unsigned) _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last)));
+
+        while (mask) {
+            size_t position = i + __builtin_ctz(mask);
+
+            if (n <= 2 || memcmp(buffer + position + 1, needle.data() + 1, n - 2) == 0)
+                return position;
+
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    auto result = (const char *) memmem(buffer + i, size - i, needle.data(), n);
+
+    if (!result)
+        return std::string::npos;
+
+    return result - buffer;
+}
+
+bool go::symbol::detail::glob(std::string_view pattern, std::string_view name) {
+    size_t p = 0;
+    size_t n = 0;
+    size_t star = std::string_view::npos;
+    size_t resume = 0;
+
+    while (n < name.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+            p++;
+            n++;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            resume = n;
+        } else if (star != std::string_view::npos) {
+            p = star + 1;
+            n = ++resume;
+        } else {
+            return false;
+        }
+    }
+
+    while (p < pattern.size() && pattern[p] == '*')
+        p++;
+
+    return p == pattern.size();
+}
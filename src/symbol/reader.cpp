@@ -2,11 +2,16 @@
 #include <elf/symbol.h>
 #include <zero/log.h>
 #include <algorithm>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #ifndef PAGE_SIZE
 #define PAGE_SIZE 0x1000
 #endif
 
+constexpr auto HUGE_PAGE_SIZE = 0x200000;
+
 constexpr auto SYMBOL_SECTION = ".gopclntab";
 constexpr auto BUILD_INFO_SECTION = "buildinfo";
 constexpr auto INTERFACE_SECTION = ".itablink";
@@ -15,17 +20,18 @@ constexpr auto SYMBOL_RODATA_SECTION = ".rodata";
 constexpr auto SYMBOL_NOPTRDATA_SECTION = ".noptrdata";
 constexpr auto SYMBOL_DATA_SECTION = ".data";
 
+constexpr auto GNU_BUILD_ID_SECTION = ".note.gnu.build-id";
+constexpr auto GO_BUILD_ID_SECTION = ".note.go.buildid";
+
 constexpr auto BUILD_INFO_MAGIC = "\xff Go buildinf:";
 constexpr auto BUILD_INFO_MAGIC_SIZE = 14;
 
 constexpr auto TYPES_SYMBOL = "runtime.types";
 constexpr auto VERSION_SYMBOL = "runtime.buildVersion";
 constexpr auto MODULE_DATA_SYMBOL = "runtime.firstmoduledata";
+constexpr auto FUNC_DATA_SYMBOL = "go:func.*";
+constexpr auto LEGACY_FUNC_DATA_SYMBOL = "go.func.*";
 
-constexpr auto SYMBOL_MAGIC_12 = 0xfffffffb;
-constexpr auto SYMBOL_MAGIC_116 = 0xfffffffa;
-constexpr auto SYMBOL_MAGIC_118 = 0xfffffff0;
-constexpr auto SYMBOL_MAGIC_120 = 0xfffffff1;
 
 go::symbol::Reader::Reader(elf::Reader reader, std::filesystem::path path)
         : mReader(std::move(reader)), mPath(std::move(path)) {
@@ -126,6 +132,93 @@ std::optional<go::Version> go::symbol::Reader::version() {
     return std::nullopt;
 }
 
+std::optional<std::string> go::symbol::Reader::buildID() {
+    std::vector<std::shared_ptr<elf::ISection>> sections = mReader.sections();
+    endian::Converter converter(endian());
+
+    auto readNote = [&](const std::string &name) -> std::optional<std::pair<const std::byte *, uint32_t>> {
+        auto it = std::find_if(sections.begin(), sections.end(), [&](const auto &section) {
+            return section->type() == SHT_NOTE && section->name() == name;
+        });
+
+        if (it == sections.end() || (*it)->size() < 12)
+            return std::nullopt;
+
+        const std::byte *data = (*it)->data();
+
+        uint32_t nameSize = converter(*(uint32_t *) data);
+        uint32_t descSize = converter(*(uint32_t *) (data + 4));
+        uint32_t descOffset = 12 + ((nameSize + 3) & ~3);
+
+        if (descOffset + descSize > (*it)->size())
+            return std::nullopt;
+
+        return std::make_pair(data + descOffset, descSize);
+    };
+
+    std::optional<std::pair<const std::byte *, uint32_t>> note = readNote(GNU_BUILD_ID_SECTION);
+
+    if (note) {
+        std::string id;
+
+        for (uint32_t i = 0; i < note->second; i++) {
+            char hex[3];
+            snprintf(hex, sizeof(hex), "%02x", std::to_integer<unsigned int>(note->first[i]));
+            id += hex;
+        }
+
+        return id;
+    }
+
+    note = readNote(GO_BUILD_ID_SECTION);
+
+    if (!note)
+        return std::nullopt;
+
+    return std::string{(const char *) note->first, note->second};
+}
+
+std::optional<uint64_t> go::symbol::Reader::imageBase() {
+    if (mReader.header()->type() != ET_DYN)
+        return std::nullopt;
+
+    std::vector<std::shared_ptr<elf::ISegment>> loads;
+    std::vector<std::shared_ptr<elf::ISegment>> segments = mReader.segments();
+
+    std::copy_if(
+            segments.begin(),
+            segments.end(),
+            std::back_inserter(loads),
+            [](const auto &segment) {
+                return segment->type() == PT_LOAD;
+            }
+    );
+
+    if (loads.empty())
+        return std::nullopt;
+
+    return std::min_element(
+            loads.begin(),
+            loads.end(),
+            [](const auto &i, const auto &j) {
+                return i->virtualAddress() < j->virtualAddress();
+            }
+    )->operator*().virtualAddress() & ~(PAGE_SIZE - 1);
+}
+
+std::shared_ptr<elf::ISection> go::symbol::Reader::section(const std::string &name) {
+    std::vector<std::shared_ptr<elf::ISection>> sections = mReader.sections();
+
+    auto it = std::find_if(sections.begin(), sections.end(), [&](const auto &section) {
+        return section->name() == name;
+    });
+
+    if (it == sections.end())
+        return nullptr;
+
+    return *it;
+}
+
 std::optional<go::symbol::BuildInfo> go::symbol::Reader::buildInfo() {
     std::vector<std::shared_ptr<elf::ISection>> sections = mReader.sections();
 
@@ -150,7 +243,19 @@ std::optional<go::symbol::BuildInfo> go::symbol::Reader::buildInfo() {
     return BuildInfo(mReader, *it);
 }
 
-std::optional<go::symbol::seek::SymbolTable> go::symbol::Reader::symbols(uint64_t base) {
+template<typename T>
+static T validated(T table, size_t concurrency) {
+    if (concurrency == 0)
+        return table;
+
+    if (!table.validate(concurrency))
+        LOG_WARNING("symbol table failed validation, lookups stay bounds checked");
+
+    return table;
+}
+
+std::optional<std::pair<std::shared_ptr<elf::ISection>, go::symbol::SymbolVersion>>
+go::symbol::Reader::symbolSection() {
     std::vector<std::shared_ptr<elf::ISection>> sections = mReader.sections();
 
     auto it = std::find_if(
@@ -166,155 +271,456 @@ std::optional<go::symbol::seek::SymbolTable> go::symbol::Reader::symbols(uint64_
         return std::nullopt;
     }
 
-    const std::byte *data = (*it)->data();
+    endian::Converter converter(endian());
+    std::optional<SymbolVersion> version = symbolVersion(converter(*(uint32_t *) (*it)->data()));
 
-    elf::endian::Type endian = this->endian();
-    endian::Converter converter(endian);
+    if (!version) {
+        LOG_ERROR("invalid symbol section magic");
+        return std::nullopt;
+    }
 
-    uint32_t magic = converter(*(uint32_t *) data);
+    return std::pair{*it, *version};
+}
 
-    SymbolVersion version;
+std::optional<go::symbol::seek::SymbolTable> go::symbol::Reader::symbols(uint64_t base, size_t validation) {
+    auto result = symbolSection();
 
-    switch (magic) {
-        case SYMBOL_MAGIC_12:
-            version = VERSION12;
-            break;
+    if (!result)
+        return std::nullopt;
 
-        case SYMBOL_MAGIC_116:
-            version = VERSION116;
-            break;
+    auto &[section, version] = *result;
+    std::optional<uint64_t> imageBase = this->imageBase();
 
-        case SYMBOL_MAGIC_118:
-            version = VERSION118;
-            break;
+    std::ifstream stream(mPath);
 
-        case SYMBOL_MAGIC_120:
-            version = VERSION120;
-            break;
+    if (!stream.is_open()) {
+        LOG_ERROR("open %s failed: %s", mPath.string().c_str(), strerror(errno));
+        return std::nullopt;
+    }
 
-        default:
-            return std::nullopt;
+    return validated(seek::SymbolTable(
+            version,
+            endian::Converter(endian()),
+            source::Stream(std::move(stream), (std::streamoff) section->offset(), section->size()),
+            imageBase ? base - *imageBase : 0
+    ), validation);
+}
+
+std::optional<go::symbol::BasicSymbolTable<go::symbol::source::File>>
+go::symbol::Reader::fileSymbols(uint64_t base, size_t validation) {
+    auto result = symbolSection();
+
+    if (!result)
+        return std::nullopt;
+
+    auto &[section, version] = *result;
+    std::optional<uint64_t> imageBase = this->imageBase();
+
+    int fd = open(mPath.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+        LOG_ERROR("open %s failed: %s", mPath.string().c_str(), strerror(errno));
+        return std::nullopt;
     }
 
-    bool dynamic = mReader.header()->type() == ET_DYN;
+    return validated(BasicSymbolTable<source::File>(
+            version,
+            endian::Converter(endian()),
+            source::File(fd, (off_t) section->offset(), section->size()),
+            imageBase ? base - *imageBase : 0
+    ), validation);
+}
 
-    std::vector<std::shared_ptr<elf::ISegment>> loads;
-    std::vector<std::shared_ptr<elf::ISegment>> segments = mReader.segments();
+std::optional<go::symbol::BasicSymbolTable<go::symbol::source::CachedFile>>
+go::symbol::Reader::cachedSymbols(uint64_t base, size_t pages, size_t validation) {
+    auto result = symbolSection();
 
-    std::copy_if(
-            segments.begin(),
-            segments.end(),
-            std::back_inserter(loads),
-            [](const auto &segment) {
-                return segment->type() == PT_LOAD;
-            }
-    );
+    if (!result)
+        return std::nullopt;
 
-    Elf64_Addr minVA = std::min_element(
-            loads.begin(),
-            loads.end(),
-            [](const auto &i, const auto &j) {
-                return i->virtualAddress() < j->virtualAddress();
-            }
-    )->operator*().virtualAddress() & ~(PAGE_SIZE - 1);
+    auto &[section, version] = *result;
+    std::optional<uint64_t> imageBase = this->imageBase();
 
-    std::ifstream stream(mPath);
+    int fd = open(mPath.c_str(), O_RDONLY | O_CLOEXEC);
 
-    if (!stream.is_open()) {
+    if (fd < 0) {
         LOG_ERROR("open %s failed: %s", mPath.string().c_str(), strerror(errno));
         return std::nullopt;
     }
 
-    return seek::SymbolTable(
+    return validated(BasicSymbolTable<source::CachedFile>(
             version,
-            converter,
-            std::move(stream),
-            (std::streamoff) (*it)->offset(),
-            (*it)->address(),
-            dynamic ? base - minVA : 0
-    );
+            endian::Converter(endian()),
+            source::CachedFile(source::File(fd, (off_t) section->offset(), section->size()), pages),
+            imageBase ? base - *imageBase : 0
+    ), validation);
 }
 
-std::optional<go::symbol::SymbolTable> go::symbol::Reader::symbols(AccessMethod method, uint64_t base) {
-    std::vector<std::shared_ptr<elf::ISection>> sections = mReader.sections();
+std::optional<go::symbol::BasicSymbolTable<go::symbol::source::Process>>
+go::symbol::Reader::processSymbols(pid_t pid, uint64_t base, size_t validation) {
+    auto result = symbolSection();
 
-    auto it = std::find_if(
-            sections.begin(),
-            sections.end(),
-            [](const auto &section) {
-                return section->name().find(SYMBOL_SECTION) != std::string::npos;
-            }
-    );
+    if (!result)
+        return std::nullopt;
 
-    if (it == sections.end()) {
-        LOG_ERROR("symbol section not found");
+    auto &[section, version] = *result;
+    std::optional<uint64_t> imageBase = this->imageBase();
+    uint64_t address = imageBase ? base + section->address() - *imageBase : section->address();
+
+    source::Process process(pid, address, section->size());
+    endian::Converter converter(endian());
+
+    uint32_t magic;
+
+    if (!process.read(0, &magic, sizeof(uint32_t)) || symbolVersion(converter(magic)) != version) {
+        LOG_ERROR("symbol section not found in process %d at 0x%lx", pid, address);
         return std::nullopt;
     }
 
-    const std::byte *data = (*it)->data();
+    // like an attached table, the loader has already relocated the image in memory, so no bias is applied.
+    return validated(BasicSymbolTable<source::Process>(version, converter, std::move(process), 0), validation);
+}
 
-    elf::endian::Type endian = this->endian();
-    endian::Converter converter(endian);
+std::optional<go::symbol::MixedSymbolizer> go::symbol::Reader::mixedSymbolizer(uint64_t base) {
+    std::optional<uint64_t> imageBase = this->imageBase();
+    uint64_t bias = imageBase ? base - *imageBase : 0;
 
-    uint32_t magic = converter(*(uint32_t *) data);
+    std::shared_ptr<const SymbolTable> table;
+    auto result = symbolSection();
 
-    SymbolVersion version;
+    if (result) {
+        auto &[section, version] = *result;
 
-    switch (magic) {
-        case SYMBOL_MAGIC_12:
-            version = VERSION12;
-            break;
+        table = std::make_shared<const SymbolTable>(
+                version,
+                endian::Converter(endian()),
+                source::Memory(section, section->size()),
+                bias
+        );
+    }
 
-        case SYMBOL_MAGIC_116:
-            version = VERSION116;
-            break;
+    std::vector<NativeSymbol> symbols;
+
+    for (const auto &section: mReader.sections()) {
+        if (section->type() != SHT_SYMTAB && section->type() != SHT_DYNSYM)
+            continue;
+
+        for (const auto &symbol: elf::SymbolTable(mReader, section)) {
+            unsigned char type = ELF64_ST_TYPE(symbol->info());
+
+            if ((type != STT_FUNC && type != STT_GNU_IFUNC) || symbol->sectionIndex() == SHN_UNDEF || !symbol->value())
+                continue;
+
+            symbols.push_back({symbol->value() + bias, symbol->size(), symbol->name()});
+        }
+    }
+
+    if (!table && symbols.empty()) {
+        LOG_ERROR("neither go nor native function symbols found");
+        return std::nullopt;
+    }
+
+    return MixedSymbolizer(std::move(table), std::move(symbols));
+}
+
+std::optional<go::symbol::InlineUnwinder> go::symbol::Reader::inlineUnwinder(uint64_t base) {
+    auto result = symbolSection();
+
+    if (!result)
+        return std::nullopt;
+
+    auto &[section, version] = *result;
+    std::optional<uint64_t> funcData = funcDataBase(version);
+
+    if (!funcData)
+        return std::nullopt;
+
+    std::optional<uint64_t> imageBase = this->imageBase();
+
+    return InlineUnwinder(
+            std::make_shared<const SymbolTable>(
+                    version,
+                    endian::Converter(endian()),
+                    source::Memory(section, section->size()),
+                    imageBase ? base - *imageBase : 0
+            ),
+            mReader,
+            endian::Converter(endian()),
+            *funcData
+    );
+}
+
+std::optional<go::symbol::ArgLayoutDecoder> go::symbol::Reader::argLayoutDecoder(uint64_t base) {
+    auto result = symbolSection();
+
+    if (!result)
+        return std::nullopt;
+
+    auto &[section, version] = *result;
+    std::optional<uint64_t> funcData = funcDataBase(version);
+
+    if (!funcData)
+        return std::nullopt;
+
+    // argument info appeared with the register abi on amd64 in go 1.17, other architectures followed in 1.18.
+    bool registerABI;
 
-        case SYMBOL_MAGIC_118:
-            version = VERSION118;
+    switch (mReader.header()->machine()) {
+        case EM_X86_64:
+            registerABI = true;
             break;
 
-        case SYMBOL_MAGIC_120:
-            version = VERSION120;
+        case EM_AARCH64:
+        case EM_PPC64:
+        case EM_RISCV:
+        case EM_LOONGARCH:
+            registerABI = version == VERSION118 || version == VERSION120;
             break;
 
         default:
-            return std::nullopt;
+            registerABI = false;
+            break;
     }
 
-    bool dynamic = mReader.header()->type() == ET_DYN;
+    std::optional<uint64_t> imageBase = this->imageBase();
+
+    return ArgLayoutDecoder(
+            std::make_shared<const SymbolTable>(
+                    version,
+                    endian::Converter(endian()),
+                    source::Memory(section, section->size()),
+                    imageBase ? base - *imageBase : 0
+            ),
+            mReader,
+            *funcData,
+            registerABI
+    );
+}
 
-    std::vector<std::shared_ptr<elf::ISegment>> loads;
-    std::vector<std::shared_ptr<elf::ISegment>> segments = mReader.segments();
+std::optional<uint64_t> go::symbol::Reader::funcDataBase(SymbolVersion version) {
+    // before go 1.18 funcdata are absolute addresses.
+    if (version != VERSION118 && version != VERSION120)
+        return 0;
 
-    std::copy_if(
-            segments.begin(),
-            segments.end(),
-            std::back_inserter(loads),
-            [](const auto &segment) {
-                return segment->type() == PT_LOAD;
-            }
-    );
+    // since go 1.18 funcdata are offsets from go:func.*, which was named go.func.* before go 1.20.
+    std::optional<uint64_t> address = findSymbolAddress(FUNC_DATA_SYMBOL);
 
-    Elf64_Addr minVA = std::min_element(
-            loads.begin(),
-            loads.end(),
-            [](const auto &i, const auto &j) {
-                return i->virtualAddress() < j->virtualAddress();
-            }
-    )->operator*().virtualAddress() & ~(PAGE_SIZE - 1);
+    if (!address)
+        address = findSymbolAddress(LEGACY_FUNC_DATA_SYMBOL);
+
+    if (!address) {
+        ensureModuleDataObject();
+
+        if (mModuleData)
+            address = mModuleData->gofunc();
+    }
+
+    if (!address) {
+        LOG_ERROR("funcdata base not found");
+        return std::nullopt;
+    }
+
+    return address;
+}
+
+static std::shared_ptr<std::byte[]> allocateHugePages(size_t size) {
+    size_t length = (size + HUGE_PAGE_SIZE - 1) & ~(size_t) (HUGE_PAGE_SIZE - 1);
+    void *ptr = mmap(nullptr, length + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (ptr == MAP_FAILED) {
+        LOG_ERROR("mmap failed: %s", strerror(errno));
+        return nullptr;
+    }
+
+    // trim the reservation so that the buffer starts on a huge page boundary.
+    auto start = ((uintptr_t) ptr + HUGE_PAGE_SIZE - 1) & ~(uintptr_t) (HUGE_PAGE_SIZE - 1);
+    auto end = (uintptr_t) ptr + length + HUGE_PAGE_SIZE;
+
+    if (start > (uintptr_t) ptr)
+        munmap(ptr, start - (uintptr_t) ptr);
+
+    if (end > start + length)
+        munmap((void *) (start + length), end - start - length);
+
+    if (madvise((void *) start, length, MADV_HUGEPAGE) < 0)
+        LOG_WARNING("madvise huge page failed: %s", strerror(errno));
+
+    return {(std::byte *) start, [=](std::byte *p) { munmap(p, length); }};
+}
+
+static std::shared_ptr<std::byte[]> partialCopy(
+        const std::filesystem::path &path,
+        const std::shared_ptr<elf::ISection> &section,
+        const std::vector<std::pair<uint64_t, uint64_t>> &regions,
+        bool hugePages
+) {
+    int fd = open(path.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+        LOG_ERROR("open %s failed: %s", path.string().c_str(), strerror(errno));
+        return nullptr;
+    }
+
+    auto pageSize = (uint64_t) sysconf(_SC_PAGESIZE);
+    uint64_t size = section->size();
+    uint64_t delta = section->offset() & (pageSize - 1);
+    uint64_t length = size + delta;
+
+    // map the whole section from the file, so that regions which are not copied are paged in on demand.
+    void *ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, (off_t) (section->offset() - delta));
+    close(fd);
+
+    if (ptr == MAP_FAILED) {
+        LOG_ERROR("mmap failed: %s", strerror(errno));
+        return nullptr;
+    }
+
+    auto mapping = (std::byte *) ptr;
+
+    for (const auto &[begin, end]: regions) {
+        uint64_t start = (delta + begin) & ~(pageSize - 1);
+        uint64_t stop = std::min(length, (delta + std::min(end, size) + pageSize - 1) & ~(pageSize - 1));
+
+        if (stop <= start)
+            continue;
+
+        if (mmap(
+                mapping + start,
+                stop - start,
+                PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED,
+                -1,
+                0
+        ) == MAP_FAILED) {
+            LOG_ERROR("mmap anonymous region failed: %s", strerror(errno));
+            munmap(mapping, length);
+            return nullptr;
+        }
+
+        // advised before the copy faults it in, only the huge page aligned extents of a region can be backed by them.
+        if (hugePages && madvise(mapping + start, stop - start, MADV_HUGEPAGE) < 0)
+            LOG_WARNING("madvise huge page failed: %s", strerror(errno));
+
+        start = std::max(start, delta);
+        stop = std::min(stop, length);
+
+        memcpy(mapping + start, section->data() + start - delta, stop - start);
+    }
+
+    mprotect(mapping, length, PROT_READ);
+
+    return {mapping + delta, [=](std::byte *) { munmap(mapping, length); }};
+}
+
+std::optional<go::symbol::SymbolTable>
+go::symbol::Reader::symbols(AccessMethod method, uint64_t base, int hints, int queries, size_t validation) {
+    auto result = symbolSection();
+
+    if (!result)
+        return std::nullopt;
+
+    auto &[section, version] = *result;
+    std::optional<uint64_t> imageBase = this->imageBase();
+
+    endian::Converter converter(endian());
+    const std::byte *data = section->data();
+    uint64_t size = section->size();
 
     if (method == FileMapping) {
-        return SymbolTable(version, converter, *it,  0);
+        SymbolTable table(version, converter, source::Memory(section, size), 0);
+
+        // advised first, so that validation faults the tables in under the requested access pattern.
+        table.advise(hints);
+        return validated(std::move(table), validation);
     } else if (method == AnonymousMemory) {
-        std::unique_ptr<std::byte[]> buffer = std::make_unique<std::byte[]>((*it)->size());
-        memcpy(buffer.get(), (*it)->data(), (*it)->size());
-        return SymbolTable(version, converter, std::move(buffer), 0);
+        if ((queries & QueryAll) != QueryAll) {
+            SymbolTable table(version, converter, source::Memory(data, size), 0);
+            std::shared_ptr<std::byte[]> buffer = partialCopy(
+                    mPath,
+                    section,
+                    table.regions(queries),
+                    hints & HugePages
+            );
+
+            if (buffer) {
+                return validated(
+                        SymbolTable(version, converter, source::Memory(std::move(buffer), size), 0),
+                        validation
+                );
+            }
+        }
+
+        if (hints & HugePages) {
+            std::shared_ptr<std::byte[]> buffer = allocateHugePages(size);
+
+            if (buffer) {
+                memcpy(buffer.get(), data, size);
+                return validated(
+                        SymbolTable(version, converter, source::Memory(std::move(buffer), size), 0),
+                        validation
+                );
+            }
+        }
+
+        std::unique_ptr<std::byte[]> buffer = std::make_unique<std::byte[]>(size);
+        memcpy(buffer.get(), data, size);
+        return validated(
+                SymbolTable(version, converter, source::Memory(std::move(buffer), size), 0),
+                validation
+        );
+    }
+
+    if (!imageBase) {
+        return validated(
+                SymbolTable(version, converter, source::Memory((const std::byte *) section->address(), size), 0),
+                validation
+        );
+    }
+
+    return validated(SymbolTable(
+            version,
+            converter,
+            source::Memory((const std::byte *) base + section->address() - *imageBase, size),
+            0
+    ), validation);
+}
+
+std::optional<go::symbol::CompactFuncTable> go::symbol::Reader::compactSymbols(uint64_t base, int queries) {
+    auto result = symbolSection();
+
+    if (!result)
+        return std::nullopt;
+
+    auto &[section, version] = *result;
+    std::optional<uint64_t> imageBase = this->imageBase();
+
+    endian::Converter converter(endian());
+    uint64_t bias = imageBase ? base - *imageBase : 0;
+    uint64_t size = section->size();
+
+    // the functab is read once from the file mapping, the private copy then leaves it out.
+    SymbolTable mapped(version, converter, source::Memory(section->data(), size), bias);
+
+    if (mapped.size() == 0) {
+        LOG_ERROR("symbol table is empty");
+        return std::nullopt;
     }
 
-    if (!dynamic)
-        return SymbolTable(version, converter, (const std::byte *) (*it)->address(), 0);
+    std::vector<std::pair<uint64_t, uint64_t>> regions = CompactFuncTable::regions(mapped, queries);
+    std::shared_ptr<std::byte[]> buffer = partialCopy(mPath, section, regions, false);
+
+    if (!buffer)
+        return std::nullopt;
+
+    CompactFuncTable table(
+            mapped,
+            std::make_shared<const SymbolTable>(version, converter, source::Memory(std::move(buffer), size), bias)
+    );
+
+    if (table.size() != mapped.size())
+        return std::nullopt;
 
-    return SymbolTable(version, converter, (const std::byte *) base + (*it)->address() - minVA, 0);
+    return table;
 }
 
 std::optional<std::pair<std::shared_ptr<elf::ISection>, uint64_t>> go::symbol::Reader::findSectionAndBase(const std::string& sectionName, uint64_t base) {
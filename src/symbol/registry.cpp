@@ -0,0 +1,132 @@
+#include <go/symbol/registry.h>
+#include <zero/log.h>
+#include <sys/stat.h>
+#include <algorithm>
+
+go::symbol::SharedSymbolTable::SharedSymbolTable(std::shared_ptr<const SymbolTable> table, uint64_t bias)
+        : mBias(bias), mTable(std::move(table)) {
+
+}
+
+go::symbol::SymbolIterator go::symbol::SharedSymbolTable::find(uint64_t address) const {
+    return mTable->find(address - mBias);
+}
+
+uint64_t go::symbol::SharedSymbolTable::address(const SymbolEntry &entry) const {
+    return entry.entry() + mBias;
+}
+
+uint64_t go::symbol::SharedSymbolTable::bias() const {
+    return mBias;
+}
+
+const go::symbol::SymbolTable &go::symbol::SharedSymbolTable::table() const {
+    return *mTable;
+}
+
+go::symbol::Registry::Registry(AccessMethod method, int hints) : mHints(hints), mMethod(method) {
+
+}
+
+std::optional<go::symbol::SharedSymbolTable>
+go::symbol::Registry::acquire(const std::filesystem::path &path, uint64_t base) {
+    if (mMethod == Attached) {
+        LOG_ERROR("attached symbol tables cannot be shared by path");
+        return std::nullopt;
+    }
+
+    struct stat st = {};
+
+    if (stat(path.c_str(), &st) < 0) {
+        LOG_ERROR("stat %s failed: %s", path.string().c_str(), strerror(errno));
+        return std::nullopt;
+    }
+
+    std::string file = std::to_string(st.st_dev) + ":" + std::to_string(st.st_ino) + ":" +
+                       std::to_string(st.st_size) + ":" + std::to_string(st.st_mtim.tv_sec) + "." +
+                       std::to_string(st.st_mtim.tv_nsec);
+
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        auto it = mFiles.find(file);
+
+        if (it != mFiles.end()) {
+            std::shared_ptr<const Image> image = mImages[it->second].lock();
+
+            if (image)
+                return bind(image, base);
+        }
+    }
+
+    std::optional<Reader> reader = openFile(path);
+
+    if (!reader)
+        return std::nullopt;
+
+    // the same binary can live at several paths, so prefer the build id over the file identity.
+    std::optional<std::string> buildID = reader->buildID();
+    std::string key = buildID ? "build-id:" + *buildID : "file:" + file;
+
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mFiles[file] = key;
+
+        std::shared_ptr<const Image> image = mImages[key].lock();
+
+        if (image)
+            return bind(image, base);
+    }
+
+    std::optional<SymbolTable> table = reader->symbols(mMethod, 0, mHints);
+
+    if (!table)
+        return std::nullopt;
+
+    std::shared_ptr<const Image> image = std::make_shared<Image>(Image{std::move(*table), reader->imageBase()});
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    std::shared_ptr<const Image> current = mImages[key].lock();
+
+    // another caller may have loaded the same binary in the meantime.
+    if (current)
+        return bind(current, base);
+
+    mImages[key] = image;
+
+    for (auto it = mImages.begin(); it != mImages.end();) {
+        if (it->second.expired()) {
+            it = mImages.erase(it);
+            continue;
+        }
+
+        ++it;
+    }
+
+    // file identities go along with the images they led to, a load still in flight records its own again below.
+    for (auto it = mFiles.begin(); it != mFiles.end();) {
+        if (mImages.find(it->second) == mImages.end()) {
+            it = mFiles.erase(it);
+            continue;
+        }
+
+        ++it;
+    }
+
+    mFiles[file] = key;
+    return bind(image, base);
+}
+
+size_t go::symbol::Registry::size() {
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    return std::count_if(mImages.begin(), mImages.end(), [](const auto &it) {
+        return !it.second.expired();
+    });
+}
+
+go::symbol::SharedSymbolTable go::symbol::Registry::bind(const std::shared_ptr<const Image> &image, uint64_t base) {
+    return {
+            std::shared_ptr<const SymbolTable>(image, &image->table),
+            image->base ? base - *image->base : 0
+    };
+}
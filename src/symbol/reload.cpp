@@ -0,0 +1,183 @@
+#include <go/symbol/reload.h>
+#include <zero/log.h>
+#include <elf.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <algorithm>
+
+template<typename Header, typename Section>
+static bool complete(int fd, uint64_t size) {
+    Header header = {};
+
+    if (pread(fd, &header, sizeof(header), 0) != sizeof(header) || header.e_shentsize != sizeof(Section))
+        return false;
+
+    std::vector<Section> sections(header.e_shnum);
+    auto length = (ssize_t) (sections.size() * sizeof(Section));
+
+    if (header.e_shoff + (uint64_t) length > size || pread(fd, sections.data(), length, (off_t) header.e_shoff) != length)
+        return false;
+
+    return std::all_of(sections.begin(), sections.end(), [=](const auto &section) {
+        return section.sh_type == SHT_NOBITS || section.sh_offset + section.sh_size <= size;
+    });
+}
+
+static bool complete(const std::filesystem::path &path) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+        return false;
+
+    struct stat st = {};
+    unsigned char ident[EI_NIDENT] = {};
+    bool result = false;
+
+    // a binary still being written has sections reaching past the end of the file.
+    if (fstat(fd, &st) == 0 && pread(fd, ident, sizeof(ident), 0) == sizeof(ident) &&
+        memcmp(ident, ELFMAG, SELFMAG) == 0) {
+        if (ident[EI_CLASS] == ELFCLASS32)
+            result = complete<Elf32_Ehdr, Elf32_Shdr>(fd, st.st_size);
+        else
+            result = complete<Elf64_Ehdr, Elf64_Shdr>(fd, st.st_size);
+    }
+
+    close(fd);
+    return result;
+}
+
+go::symbol::ReloadableSymbolTable::ReloadableSymbolTable(
+        std::filesystem::path path,
+        std::chrono::milliseconds interval,
+        AccessMethod method,
+        int hints
+) : mHints(hints), mMethod(method), mPath(std::move(path)), mInterval(interval) {
+    // a binary overwritten in place truncates the pages under a mapping that readers may still hold.
+    if (mMethod == FileMapping) {
+        LOG_WARNING("file mapping is not safe against in-place updates, copying %s instead", mPath.string().c_str());
+        mMethod = AnonymousMemory;
+    }
+
+    poll();
+
+    mThread = std::thread([this] {
+        std::unique_lock<std::mutex> lock(mMutex);
+
+        while (!mCondition.wait_for(lock, mInterval, [this] { return mStopped; })) {
+            lock.unlock();
+            poll();
+            lock.lock();
+        }
+    });
+}
+
+go::symbol::ReloadableSymbolTable::~ReloadableSymbolTable() {
+    stop();
+}
+
+std::shared_ptr<const go::symbol::SymbolTable> go::symbol::ReloadableSymbolTable::current() const {
+    std::shared_ptr<const Image> image = std::atomic_load(&mImage);
+
+    if (!image)
+        return nullptr;
+
+    return {image, &image->table};
+}
+
+std::optional<go::symbol::SharedSymbolTable> go::symbol::ReloadableSymbolTable::acquire(uint64_t base) const {
+    std::shared_ptr<const Image> image = std::atomic_load(&mImage);
+
+    if (!image)
+        return std::nullopt;
+
+    // a rebuilt binary may come with another image base, so the bias follows the published image.
+    return SharedSymbolTable(
+            std::shared_ptr<const SymbolTable>(image, &image->table),
+            image->base ? base - *image->base : 0
+    );
+}
+
+uint64_t go::symbol::ReloadableSymbolTable::generation() const {
+    return mGeneration;
+}
+
+bool go::symbol::ReloadableSymbolTable::poll() {
+    std::lock_guard<std::mutex> guard(mReloadMutex);
+    std::optional<std::string> identity = this->identity();
+
+    if (!identity || *identity == mIdentity)
+        return false;
+
+    // a binary still being written is skipped, the next poll retries it.
+    if (!complete(mPath))
+        return false;
+
+    std::optional<Reader> reader = openFile(mPath);
+
+    if (!reader)
+        return false;
+
+    std::optional<std::string> buildID = reader->buildID();
+    std::shared_ptr<const Image> image = std::atomic_load(&mImage);
+
+    // copying a binary over itself or touching it changes the file, but not the symbols.
+    if (image && buildID && image->buildID == buildID) {
+        mIdentity = *identity;
+        return false;
+    }
+
+    // only a table checked as a whole replaces the one being served, validation is opt-in so it is asked for here.
+    std::optional<SymbolTable> table = reader->symbols(
+            mMethod,
+            0,
+            mHints,
+            QueryAll,
+            std::max<size_t>(1, std::thread::hardware_concurrency())
+    );
+
+    if (!table || !table->validated()) {
+        LOG_WARNING("reload %s failed, keep serving generation %lu", mPath.string().c_str(), mGeneration.load());
+        return false;
+    }
+
+    // readers holding the previous image keep it, and its mapping, alive until they drop it.
+    std::atomic_store(
+            &mImage,
+            std::shared_ptr<const Image>(std::make_shared<Image>(Image{
+                    std::move(*table),
+                    reader->imageBase(),
+                    std::move(buildID)
+            }))
+    );
+
+    mIdentity = *identity;
+    mGeneration++;
+
+    return true;
+}
+
+void go::symbol::ReloadableSymbolTable::stop() {
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mStopped = true;
+    }
+
+    mCondition.notify_all();
+
+    if (mThread.joinable())
+        mThread.join();
+}
+
+std::optional<std::string> go::symbol::ReloadableSymbolTable::identity() const {
+    struct stat st = {};
+
+    if (stat(mPath.c_str(), &st) < 0) {
+        LOG_ERROR("stat %s failed: %s", mPath.string().c_str(), strerror(errno));
+        return std::nullopt;
+    }
+
+    return std::to_string(st.st_dev) + ":" + std::to_string(st.st_ino) + ":" +
+           std::to_string(st.st_size) + ":" + std::to_string(st.st_mtim.tv_sec) + "." +
+           std::to_string(st.st_mtim.tv_nsec);
+}
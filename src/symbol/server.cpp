@@ -0,0 +1,577 @@
+#include <go/symbol/server.h>
+#include <zero/log.h>
+#include <cstring>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+constexpr auto LISTEN_BACKLOG = 64;
+constexpr auto READ_BUFFER_SIZE = 64 * 1024;
+constexpr auto MAX_PENDING_OUTPUT = 16 << 20;
+
+namespace {
+    // names are deduplicated into the string block that ends a response, keyed by views into stable storage.
+    class Strings {
+    public:
+        uint32_t add(std::string_view str) {
+            if (str.empty())
+                return go::symbol::protocol::NO_STRING;
+
+            auto [it, inserted] = mOffsets.try_emplace(str, (uint32_t) mBlock.size());
+
+            if (inserted) {
+                mBlock.append(str);
+                mBlock.push_back('\0');
+            }
+
+            return it->second;
+        }
+
+        [[nodiscard]] const std::string &block() const {
+            return mBlock;
+        }
+
+    private:
+        std::string mBlock;
+        std::unordered_map<std::string_view, uint32_t> mOffsets;
+    };
+}
+
+template<typename T>
+static void append(std::vector<std::byte> &buffer, const T &value) {
+    const auto *p = (const std::byte *) &value;
+    buffer.insert(buffer.end(), p, p + sizeof(T));
+}
+
+static void append(std::vector<std::byte> &buffer, const std::string &block) {
+    const auto *p = (const std::byte *) block.data();
+    buffer.insert(buffer.end(), p, p + block.size());
+}
+
+static std::optional<std::string> identity(const std::string &path) {
+    struct stat st = {};
+
+    if (stat(path.c_str(), &st) < 0) {
+        LOG_ERROR("stat %s failed: %s", path.c_str(), strerror(errno));
+        return std::nullopt;
+    }
+
+    return std::to_string(st.st_dev) + ":" + std::to_string(st.st_ino) + ":" + std::to_string(st.st_size) + ":" +
+           std::to_string(st.st_mtim.tv_sec) + "." + std::to_string(st.st_mtim.tv_nsec);
+}
+
+// the reply never changes for a build, so it is encoded once when the binary is loaded, empty without build info.
+static std::vector<std::byte> encodeBuildInfo(go::symbol::Reader &reader) {
+    std::optional<go::symbol::BuildInfo> info = reader.buildInfo();
+
+    if (!info)
+        return {};
+
+    std::optional<go::Version> version = info->version();
+    std::optional<go::symbol::ModuleInfo> modules = info->moduleInfo();
+    std::optional<std::string> buildID = reader.buildID();
+
+    Strings strings;
+    std::vector<go::symbol::protocol::ModuleRecord> records;
+
+    auto record = [&](const go::symbol::Module &module) {
+        go::symbol::protocol::ModuleRecord record = {
+                strings.add(module.path),
+                strings.add(module.version),
+                strings.add(module.sum),
+                go::symbol::protocol::NO_STRING,
+                go::symbol::protocol::NO_STRING,
+                go::symbol::protocol::NO_STRING
+        };
+
+        if (module.replace) {
+            record.replacePath = strings.add(module.replace->path);
+            record.replaceVersion = strings.add(module.replace->version);
+            record.replaceSum = strings.add(module.replace->sum);
+        }
+
+        records.push_back(record);
+    };
+
+    go::symbol::protocol::BuildInfoResponse header = {};
+
+    header.major = version ? version->major : 0;
+    header.minor = version ? version->minor : 0;
+    header.buildID = buildID ? strings.add(*buildID) : go::symbol::protocol::NO_STRING;
+    header.package = go::symbol::protocol::NO_STRING;
+
+    if (modules) {
+        header.package = strings.add(modules->path);
+        record(modules->main);
+
+        for (const auto &dep: modules->deps)
+            record(dep);
+    }
+
+    header.count = records.size();
+    header.stringsSize = strings.block().size();
+
+    std::vector<std::byte> reply;
+    append(reply, header);
+
+    const auto *p = (const std::byte *) records.data();
+    reply.insert(reply.end(), p, p + records.size() * sizeof(go::symbol::protocol::ModuleRecord));
+
+    append(reply, strings.block());
+    return reply;
+}
+
+go::symbol::Server::Server(
+        std::filesystem::path path,
+        AccessMethod method,
+        int hints,
+        size_t capacity,
+        mode_t mode
+) : mMode(mode), mCapacity(std::max<size_t>(1, capacity)), mPath(std::move(path)), mRegistry(method, hints) {
+
+}
+
+go::symbol::Server::~Server() {
+    stop();
+
+    if (mFD >= 0) {
+        close(mFD);
+        unlink(mPath.c_str());
+    }
+
+    for (const auto &fd: mWakeup) {
+        if (fd >= 0)
+            close(fd);
+    }
+}
+
+bool go::symbol::Server::listen() {
+    if (pipe2(mWakeup, O_CLOEXEC) < 0) {
+        LOG_ERROR("create pipe failed: %s", strerror(errno));
+        return false;
+    }
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+
+    if (mPath.string().size() >= sizeof(address.sun_path)) {
+        LOG_ERROR("socket path %s too long", mPath.string().c_str());
+        return false;
+    }
+
+    strcpy(address.sun_path, mPath.c_str());
+
+    // a socket left behind by a previous daemon would fail the bind, other files are never removed.
+    struct stat st = {};
+
+    if (lstat(mPath.c_str(), &st) == 0 && S_ISSOCK(st.st_mode))
+        unlink(mPath.c_str());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (fd < 0) {
+        LOG_ERROR("create socket failed: %s", strerror(errno));
+        return false;
+    }
+
+    if (bind(fd, (const sockaddr *) &address, sizeof(address)) < 0) {
+        LOG_ERROR("bind %s failed: %s", mPath.string().c_str(), strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    // nothing can connect before listen, so the socket is never reachable with the umask's permissions.
+    if (chmod(mPath.c_str(), mMode) < 0) {
+        LOG_ERROR("chmod %s failed: %s", mPath.string().c_str(), strerror(errno));
+        close(fd);
+        unlink(mPath.c_str());
+        return false;
+    }
+
+    if (::listen(fd, LISTEN_BACKLOG) < 0) {
+        LOG_ERROR("listen %s failed: %s", mPath.string().c_str(), strerror(errno));
+        close(fd);
+        unlink(mPath.c_str());
+        return false;
+    }
+
+    mFD = fd;
+    return true;
+}
+
+void go::symbol::Server::serve() {
+    while (!mStopped) {
+        pollfd fds[2] = {{mFD, POLLIN, 0}, {mWakeup[0], POLLIN, 0}};
+
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+
+            LOG_ERROR("poll failed: %s", strerror(errno));
+            break;
+        }
+
+        if (fds[1].revents)
+            break;
+
+        int fd = accept4(mFD, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+
+        if (fd < 0) {
+            if (errno != EINTR && errno != EAGAIN && errno != ECONNABORTED)
+                LOG_WARNING("accept failed: %s", strerror(errno));
+
+            continue;
+        }
+
+        for (auto it = mConnections.begin(); it != mConnections.end();) {
+            if (!*it->done) {
+                ++it;
+                continue;
+            }
+
+            it->thread.join();
+            it = mConnections.erase(it);
+        }
+
+        auto done = std::make_shared<std::atomic<bool>>(false);
+
+        mConnections.push_back({
+                std::thread([=]() {
+                    handle(fd);
+                    *done = true;
+                }),
+                done
+        });
+    }
+
+    for (auto &connection: mConnections)
+        connection.thread.join();
+
+    mConnections.clear();
+}
+
+void go::symbol::Server::stop() {
+    if (mStopped.exchange(true))
+        return;
+
+    // only async-signal-safe calls, so a signal handler may stop the daemon.
+    if (mWakeup[1] >= 0) {
+        char c = 0;
+        ssize_t n = write(mWakeup[1], &c, 1);
+        (void) n;
+    }
+}
+
+std::shared_ptr<go::symbol::Server::Binary> go::symbol::Server::binary(const std::string &path) {
+    std::optional<std::string> identity = ::identity(path);
+
+    if (!identity)
+        return nullptr;
+
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        auto it = mPaths.find(path);
+
+        if (it != mPaths.end() && it->second->second->identity == *identity) {
+            mBinaries.splice(mBinaries.begin(), mBinaries, it->second);
+            return it->second->second;
+        }
+    }
+
+    std::optional<Reader> reader = openFile(path);
+
+    if (!reader)
+        return nullptr;
+
+    // the registry shares one table between paths of the same build, holding it here keeps it resident.
+    std::optional<SharedSymbolTable> table = mRegistry.acquire(path);
+
+    if (!table)
+        return nullptr;
+
+    std::optional<StructTable> types = reader->typeLinks();
+
+    std::shared_ptr<Binary> binary(new Binary{
+            *identity,
+            std::move(*table),
+            reader->imageBase(),
+            types ? std::make_shared<const TypeIndex>(*types) : nullptr,
+            encodeBuildInfo(*reader)
+    });
+
+    // a binary replaced on disk drops the entry of its previous build.
+    std::lock_guard<std::mutex> guard(mMutex);
+    auto it = mPaths.find(path);
+
+    if (it != mPaths.end())
+        mBinaries.erase(it->second);
+
+    mBinaries.emplace_front(path, binary);
+    mPaths[path] = mBinaries.begin();
+
+    // connections still using an evicted binary keep it alive until their requests finish.
+    while (mBinaries.size() > mCapacity) {
+        mPaths.erase(mBinaries.back().first);
+        mBinaries.pop_back();
+    }
+
+    return binary;
+}
+
+void go::symbol::Server::handle(int fd) {
+    std::vector<std::byte> input;
+    std::vector<std::byte> output;
+
+    size_t written = 0;
+    bool closing = false;
+
+    while (!mStopped) {
+        pollfd fds[2] = {{fd, 0, 0}, {mWakeup[0], POLLIN, 0}};
+
+        // a client that pipelines without reading stops being read once its replies pile up.
+        if (!closing && output.size() - written < MAX_PENDING_OUTPUT)
+            fds[0].events |= POLLIN;
+
+        if (written < output.size())
+            fds[0].events |= POLLOUT;
+
+        if (closing && !fds[0].events)
+            break;
+
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+
+            LOG_ERROR("poll failed: %s", strerror(errno));
+            break;
+        }
+
+        if (fds[1].revents)
+            break;
+
+        if (fds[0].revents & POLLOUT) {
+            ssize_t n = send(fd, output.data() + written, output.size() - written, MSG_NOSIGNAL);
+
+            if (n < 0 && errno != EAGAIN && errno != EINTR)
+                break;
+
+            if (n > 0)
+                written += n;
+
+            if (written == output.size()) {
+                output.clear();
+                written = 0;
+            }
+        }
+
+        if (!(fds[0].events & POLLIN) || !(fds[0].revents & (POLLIN | POLLHUP | POLLERR)))
+            continue;
+
+        size_t size = input.size();
+        input.resize(size + READ_BUFFER_SIZE);
+
+        ssize_t n = recv(fd, input.data() + size, READ_BUFFER_SIZE, 0);
+
+        if (n < 0) {
+            input.resize(size);
+
+            if (errno == EAGAIN || errno == EINTR)
+                continue;
+
+            break;
+        }
+
+        input.resize(size + n);
+
+        // the peer may half-close after its last request and still wait for the replies.
+        if (n == 0)
+            closing = true;
+
+        size_t consumed = 0;
+
+        while (input.size() - consumed >= sizeof(protocol::Header)) {
+            protocol::Header header = {};
+            memcpy(&header, input.data() + consumed, sizeof(header));
+
+            uint32_t length = header.length;
+
+            size_t start = output.size();
+            output.resize(start + sizeof(header));
+
+            uint16_t status;
+
+            if (length > protocol::MAX_PAYLOAD) {
+                status = protocol::STATUS_TOO_LARGE;
+                closing = true;
+            } else if (input.size() - consumed - sizeof(header) < length) {
+                output.resize(start);
+                break;
+            } else {
+                status = dispatch(header.type, input.data() + consumed + sizeof(header), length, output);
+            }
+
+            if (status != protocol::STATUS_OK)
+                output.resize(start + sizeof(header));
+
+            header.length = output.size() - start - sizeof(header);
+            header.status = status;
+
+            memcpy(output.data() + start, &header, sizeof(header));
+
+            if (closing && status == protocol::STATUS_TOO_LARGE) {
+                consumed = input.size();
+                break;
+            }
+
+            consumed += sizeof(header) + length;
+        }
+
+        input.erase(input.begin(), input.begin() + (ptrdiff_t) consumed);
+    }
+
+    close(fd);
+}
+
+uint16_t
+go::symbol::Server::dispatch(uint16_t type, const std::byte *payload, size_t length, std::vector<std::byte> &response) {
+    switch (type) {
+        case protocol::SYMBOLIZE:
+            return symbolize(payload, length, response);
+
+        case protocol::FIELD_OFFSETS:
+            return fieldOffsets(payload, length, response);
+
+        case protocol::BUILD_INFO:
+            return buildInfo(payload, length, response);
+
+        default:
+            return protocol::STATUS_UNKNOWN_TYPE;
+    }
+}
+
+uint16_t go::symbol::Server::symbolize(const std::byte *payload, size_t length, std::vector<std::byte> &response) {
+    protocol::SymbolizeRequest request = {};
+
+    if (length < sizeof(request))
+        return protocol::STATUS_MALFORMED;
+
+    memcpy(&request, payload, sizeof(request));
+
+    uint64_t offset = (sizeof(request) + uint64_t(request.pathLength) + 7) & ~uint64_t(7);
+
+    if (!request.pathLength || offset + uint64_t(request.count) * sizeof(uint64_t) != length)
+        return protocol::STATUS_MALFORMED;
+
+    std::shared_ptr<Binary> binary = this->binary({(const char *) payload + sizeof(request), request.pathLength});
+
+    if (!binary)
+        return protocol::STATUS_OPEN_FAILED;
+
+    const SymbolTable &table = binary->table.table();
+    uint64_t bias = binary->imageBase ? request.base - *binary->imageBase : 0;
+
+    Strings strings;
+    std::vector<protocol::FrameRecord> records(request.count);
+
+    // names and files are views into the resident table, so the string block is the only copy.
+    for (size_t i = 0; i < request.count; i++) {
+        uint64_t pc;
+        memcpy(&pc, payload + offset + i * sizeof(uint64_t), sizeof(pc));
+
+        pc -= bias;
+        auto it = table.find(pc);
+
+        if (it == table.end()) {
+            records[i] = {0, protocol::NO_STRING, protocol::NO_STRING, -1, 0};
+            continue;
+        }
+
+        SymbolEntry entry = *it;
+        Symbol symbol = entry.symbol();
+
+        records[i] = {
+                entry.entry() + bias,
+                strings.add(table.functionName(entry.index())),
+                strings.add(symbol.sourceFile(pc)),
+                symbol.sourceLine(pc),
+                0
+        };
+    }
+
+    append(response, protocol::SymbolizeResponse{request.count, (uint32_t) strings.block().size()});
+
+    const auto *p = (const std::byte *) records.data();
+    response.insert(response.end(), p, p + records.size() * sizeof(protocol::FrameRecord));
+
+    append(response, strings.block());
+    return protocol::STATUS_OK;
+}
+
+uint16_t go::symbol::Server::fieldOffsets(const std::byte *payload, size_t length, std::vector<std::byte> &response) {
+    protocol::FieldOffsetsRequest request = {};
+
+    if (length < sizeof(request))
+        return protocol::STATUS_MALFORMED;
+
+    memcpy(&request, payload, sizeof(request));
+
+    if (!request.pathLength || !request.typeLength ||
+        sizeof(request) + uint64_t(request.pathLength) + request.typeLength != length)
+        return protocol::STATUS_MALFORMED;
+
+    const char *path = (const char *) payload + sizeof(request);
+    std::shared_ptr<Binary> binary = this->binary({path, request.pathLength});
+
+    if (!binary)
+        return protocol::STATUS_OPEN_FAILED;
+
+    std::optional<std::vector<FieldOffset>> fields;
+
+    if (binary->types)
+        fields = binary->types->fields({path + request.pathLength, request.typeLength});
+
+    if (!fields)
+        return protocol::STATUS_NOT_FOUND;
+
+    Strings strings;
+    std::vector<protocol::FieldRecord> records;
+
+    records.reserve(fields->size());
+
+    for (const auto &field: *fields)
+        records.push_back({field.offset, strings.add(field.name), 0});
+
+    append(response, protocol::FieldOffsetsResponse{(uint32_t) records.size(), (uint32_t) strings.block().size()});
+
+    const auto *p = (const std::byte *) records.data();
+    response.insert(response.end(), p, p + records.size() * sizeof(protocol::FieldRecord));
+
+    append(response, strings.block());
+    return protocol::STATUS_OK;
+}
+
+uint16_t go::symbol::Server::buildInfo(const std::byte *payload, size_t length, std::vector<std::byte> &response) {
+    protocol::BuildInfoRequest request = {};
+
+    if (length < sizeof(request))
+        return protocol::STATUS_MALFORMED;
+
+    memcpy(&request, payload, sizeof(request));
+
+    if (!request.pathLength || sizeof(request) + uint64_t(request.pathLength) != length)
+        return protocol::STATUS_MALFORMED;
+
+    std::shared_ptr<Binary> binary = this->binary({(const char *) payload + sizeof(request), request.pathLength});
+
+    if (!binary)
+        return protocol::STATUS_OPEN_FAILED;
+
+    if (binary->buildInfo.empty())
+        return protocol::STATUS_NOT_FOUND;
+
+    response.insert(response.end(), binary->buildInfo.begin(), binary->buildInfo.end());
+    return protocol::STATUS_OK;
+}
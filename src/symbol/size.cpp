@@ -0,0 +1,165 @@
+#include <go/symbol/size.h>
+#include <go/symbol/module_index.h>
+#include <zero/log.h>
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
+
+constexpr auto NO_FILE = UINT32_MAX;
+constexpr auto UNKNOWN_NAME = "<unknown>";
+
+namespace {
+    struct Totals {
+        uint64_t size;
+        uint64_t count;
+    };
+
+    struct Aggregate {
+        uint64_t text;
+        std::unordered_map<std::string_view, Totals> packages;
+        std::unordered_map<uint32_t, Totals> files;
+    };
+}
+
+static void collect(const go::symbol::SymbolTable &table, size_t begin, size_t end, Aggregate &aggregate) {
+    for (size_t i = begin; i < end; i++) {
+        go::symbol::SymbolEntry entry = table[i];
+        uint64_t size = table[i + 1].entry() - entry.entry();
+
+        Totals &package = aggregate.packages[go::symbol::detail::packagePath(table.functionName(i))];
+        Totals &file = aggregate.files[entry.symbol().fileID(entry.entry()).value_or(NO_FILE)];
+
+        package.size += size;
+        package.count++;
+
+        file.size += size;
+        file.count++;
+
+        aggregate.text += size;
+    }
+}
+
+template<typename Map, typename F>
+static std::vector<go::symbol::SizeEntry> sorted(const Map &map, F &&name) {
+    std::vector<go::symbol::SizeEntry> entries;
+    entries.reserve(map.size());
+
+    for (const auto &[key, totals]: map)
+        entries.push_back({name(key), totals.size, totals.count});
+
+    std::sort(entries.begin(), entries.end(), [](const auto &lhs, const auto &rhs) {
+        if (lhs.size != rhs.size)
+            return lhs.size > rhs.size;
+
+        return lhs.name < rhs.name;
+    });
+
+    return entries;
+}
+
+std::optional<go::symbol::SizeReport> go::symbol::attributeSizes(Reader &reader, size_t concurrency) {
+    std::optional<SymbolTable> table = reader.symbols(FileMapping);
+
+    if (!table)
+        return std::nullopt;
+
+    size_t size = table->size();
+    concurrency = std::max<size_t>(1, std::min<size_t>(concurrency, size / detail::MIN_PARALLEL_FUNCTIONS));
+
+    size_t step = (size + concurrency - 1) / concurrency;
+
+    std::vector<Aggregate> parts(concurrency);
+    std::vector<std::thread> threads;
+
+    for (size_t i = 1; i < concurrency; i++) {
+        threads.emplace_back([=, &table, &parts]() {
+            collect(*table, i * step, std::min(size, (i + 1) * step), parts[i]);
+        });
+    }
+
+    collect(*table, 0, std::min(size, step), parts[0]);
+
+    for (auto &thread: threads)
+        thread.join();
+
+    Aggregate &aggregate = parts[0];
+
+    for (size_t i = 1; i < parts.size(); i++) {
+        aggregate.text += parts[i].text;
+
+        for (const auto &[key, totals]: parts[i].packages) {
+            Totals &merged = aggregate.packages[key];
+
+            merged.size += totals.size;
+            merged.count += totals.count;
+        }
+
+        for (const auto &[key, totals]: parts[i].files) {
+            Totals &merged = aggregate.files[key];
+
+            merged.size += totals.size;
+            merged.count += totals.count;
+        }
+    }
+
+    SizeReport report = {aggregate.text, table->layout()};
+
+    report.packages = sorted(aggregate.packages, [](std::string_view package) {
+        return package.empty() ? std::string(UNKNOWN_NAME) : std::string(package);
+    });
+
+    report.files = sorted(aggregate.files, [&](uint32_t id) {
+        return id == NO_FILE ? std::string(UNKNOWN_NAME) : std::string(table->fileName(id));
+    });
+
+    size_t ptrSize = reader.ptrSize();
+    std::optional<StructTable> types = reader.typeLinks();
+
+    if (types) {
+        std::vector<std::pair<uint64_t, size_t>> descriptors;
+        descriptors.reserve(types->size());
+
+        for (size_t i = 0; i < types->size(); i++)
+            descriptors.emplace_back((*types)[i].address(), i);
+
+        std::sort(descriptors.begin(), descriptors.end());
+
+        std::unordered_map<std::string, Totals> totals;
+
+        // descriptors carry variable trailing data, so each one is charged up to the next known descriptor.
+        // types missing from typelinks are thereby charged to their predecessor, which makes this an estimate.
+        for (size_t i = 0; i < descriptors.size(); i++) {
+            uint64_t bytes = i + 1 < descriptors.size() ?
+                             descriptors[i + 1].first - descriptors[i].first : 4 * ptrSize + 16;
+
+            Totals &type = totals[(*types)[descriptors[i].second].name().value_or(UNKNOWN_NAME)];
+
+            type.size += bytes;
+            type.count++;
+        }
+
+        report.types = sorted(totals, [](const std::string &name) {
+            return name;
+        });
+    }
+
+    std::optional<InterfaceTable> interfaces = reader.interfaces();
+
+    if (interfaces) {
+        std::unordered_map<std::string, Totals> totals;
+
+        // inter and _type pointers, the hash padded to 8 bytes, then one pointer per method.
+        for (const auto &itab: *interfaces) {
+            Totals &type = totals[itab.name().value_or(UNKNOWN_NAME)];
+
+            type.size += 2 * ptrSize + 8 + itab.methodCount() * ptrSize;
+            type.count++;
+        }
+
+        report.itabs = sorted(totals, [](const std::string &name) {
+            return name;
+        });
+    }
+
+    return report;
+}
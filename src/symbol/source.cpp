@@ -0,0 +1,150 @@
+#include <go/symbol/source.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+constexpr auto CACHE_PAGE_SIZE = 0x1000;
+constexpr auto INVALID_TAG = UINT64_MAX;
+
+go::symbol::source::Memory::Memory(Buffer buffer, size_t size) : mSize(size), mBuffer(std::move(buffer)) {
+    size_t index = mBuffer.index();
+
+    if (index == 0) {
+        mData = std::get<std::shared_ptr<elf::ISection>>(mBuffer)->data();
+    } else if (index == 1) {
+        mData = std::get<std::unique_ptr<std::byte[]>>(mBuffer).get();
+    } else if (index == 3) {
+        mData = std::get<std::shared_ptr<std::byte[]>>(mBuffer).get();
+    } else {
+        mData = std::get<const std::byte *>(mBuffer);
+    }
+}
+
+go::symbol::source::Stream::Stream(std::ifstream stream, std::streamoff offset, size_t size)
+        : mSize(size), mOffset(offset), mStream(std::move(stream)) {
+
+}
+
+size_t go::symbol::source::Stream::size() const {
+    return mSize;
+}
+
+bool go::symbol::source::Stream::read(uint64_t offset, void *buffer, size_t length) const {
+    if (offset > mSize || length > mSize - offset)
+        return false;
+
+    mStream.clear();
+    mStream.seekg(mOffset + (std::streamoff) offset, std::ifstream::beg);
+    mStream.read((char *) buffer, (std::streamsize) length);
+
+    return (size_t) mStream.gcount() == length;
+}
+
+go::symbol::source::File::File(int fd, off_t offset, size_t size)
+        : mSize(size), mOffset(offset), mFD(new int(fd), [](const int *p) { close(*p); delete p; }) {
+
+}
+
+size_t go::symbol::source::File::size() const {
+    return mSize;
+}
+
+bool go::symbol::source::File::read(uint64_t offset, void *buffer, size_t length) const {
+    if (offset > mSize || length > mSize - offset)
+        return false;
+
+    size_t count = 0;
+
+    while (count < length) {
+        ssize_t n = pread(*mFD, (std::byte *) buffer + count, length - count, mOffset + (off_t) (offset + count));
+
+        if (n < 0 && errno == EINTR)
+            continue;
+
+        if (n <= 0)
+            return false;
+
+        count += n;
+    }
+
+    return true;
+}
+
+int go::symbol::source::File::fd() const {
+    return *mFD;
+}
+
+off_t go::symbol::source::File::offset() const {
+    return mOffset;
+}
+
+go::symbol::source::CachedFile::CachedFile(File file, size_t pages)
+        : mFile(std::move(file)), mPages(std::max<size_t>(pages, 1)), mCache(std::make_shared<Cache>()) {
+    mCache->tags.resize(mPages, INVALID_TAG);
+    mCache->pages = std::make_unique<std::byte[]>(mPages * CACHE_PAGE_SIZE);
+}
+
+size_t go::symbol::source::CachedFile::size() const {
+    return mFile.size();
+}
+
+bool go::symbol::source::CachedFile::read(uint64_t offset, void *buffer, size_t length) const {
+    if (offset > mFile.size() || length > mFile.size() - offset)
+        return false;
+
+    std::lock_guard<std::mutex> guard(mCache->mutex);
+
+    while (length > 0) {
+        uint64_t page = offset / CACHE_PAGE_SIZE;
+        uint64_t slot = page % mPages;
+        std::byte *data = mCache->pages.get() + slot * CACHE_PAGE_SIZE;
+
+        // direct-mapped: a page always lands in the same slot, evicting whatever was there.
+        if (mCache->tags[slot] != page) {
+            uint64_t start = page * CACHE_PAGE_SIZE;
+
+            if (start >= mFile.size())
+                return false;
+
+            if (!mFile.read(start, data, std::min<uint64_t>(CACHE_PAGE_SIZE, mFile.size() - start))) {
+                mCache->tags[slot] = INVALID_TAG;
+                return false;
+            }
+
+            mCache->tags[slot] = page;
+        }
+
+        size_t n = std::min<size_t>(length, CACHE_PAGE_SIZE - offset % CACHE_PAGE_SIZE);
+        memcpy(buffer, data + offset % CACHE_PAGE_SIZE, n);
+
+        buffer = (std::byte *) buffer + n;
+        offset += n;
+        length -= n;
+    }
+
+    return true;
+}
+
+go::symbol::source::Process::Process(pid_t pid, uint64_t address, size_t size)
+        : mPID(pid), mSize(size), mAddress(address) {
+
+}
+
+size_t go::symbol::source::Process::size() const {
+    return mSize;
+}
+
+bool go::symbol::source::Process::read(uint64_t offset, void *buffer, size_t length) const {
+    if (offset > mSize || length > mSize - offset)
+        return false;
+
+    iovec local = {buffer, length};
+    iovec remote = {(void *) (mAddress + offset), length};
+
+    // failures are reported by the caller, this sits on the lookup path.
+    ssize_t n = process_vm_readv(mPID, &local, 1, &remote, 1, 0);
+
+    if (n < 0)
+        return false;
+
+    return (size_t) n == length;
+}
@@ -1,642 +1,258 @@
 #include <go/symbol/symbol.h>
-#include <go/binary.h>
-#include <algorithm>
+#include <zero/log.h>
 #include <cstring>
 #include <unistd.h>
-
-constexpr auto MAX_VAR_INT_LENGTH = 10;
-
-constexpr auto STACK_TOP_FUNCTION = {
-        "runtime.mstart",
-        "runtime.rt0_go",
-        "runtime.mcall",
-        "runtime.morestack",
-        "runtime.lessstack",
-        "runtime.asmcgocall",
-        "runtime.externalthreadhandler",
-        "runtime.goexit"
+#include <sys/mman.h>
+
+constexpr auto SYMBOL_MAGIC_12 = 0xfffffffb;
+constexpr auto SYMBOL_MAGIC_116 = 0xfffffffa;
+constexpr auto SYMBOL_MAGIC_118 = 0xfffffff0;
+constexpr auto SYMBOL_MAGIC_120 = 0xfffffff1;
+
+constexpr auto RUNTIME_PREFIX = "runtime.";
+
+constexpr std::pair<std::string_view, go::symbol::FuncID> RUNTIME_FUNC_IDS[] = {
+        {"abort",                  go::symbol::FUNC_ID_ABORT},
+        {"asmcgocall",             go::symbol::FUNC_ID_ASM_CGO_CALL},
+        {"asyncPreempt",           go::symbol::FUNC_ID_ASYNC_PREEMPT},
+        {"cgocallback",            go::symbol::FUNC_ID_CGO_CALLBACK},
+        {"cgocallback_gofunc",     go::symbol::FUNC_ID_CGO_CALLBACK},
+        {"corostart",              go::symbol::FUNC_ID_CORO_START},
+        {"debugCallV1",            go::symbol::FUNC_ID_DEBUG_CALL},
+        {"debugCallV2",            go::symbol::FUNC_ID_DEBUG_CALL},
+        {"externalthreadhandler",  go::symbol::FUNC_ID_EXTERNAL_THREAD_HANDLER},
+        {"gcBgMarkWorker",         go::symbol::FUNC_ID_GC_BG_MARK_WORKER},
+        {"goexit",                 go::symbol::FUNC_ID_GO_EXIT},
+        {"gogo",                   go::symbol::FUNC_ID_GO_GO},
+        {"gopanic",                go::symbol::FUNC_ID_GO_PANIC},
+        {"handleAsyncEvent",       go::symbol::FUNC_ID_HANDLE_ASYNC_EVENT},
+        {"jmpdefer",               go::symbol::FUNC_ID_JMP_DEFER},
+        {"lessstack",              go::symbol::FUNC_ID_LESS_STACK},
+        {"main",                   go::symbol::FUNC_ID_RUNTIME_MAIN},
+        {"mcall",                  go::symbol::FUNC_ID_MCALL},
+        {"morestack",              go::symbol::FUNC_ID_MORE_STACK},
+        {"mstart",                 go::symbol::FUNC_ID_MSTART},
+        {"panicwrap",              go::symbol::FUNC_ID_PANIC_WRAP},
+        {"rt0_go",                 go::symbol::FUNC_ID_RT0_GO},
+        {"runfinq",                go::symbol::FUNC_ID_RUN_FINQ},
+        {"sigpanic",               go::symbol::FUNC_ID_SIG_PANIC},
+        {"systemstack",            go::symbol::FUNC_ID_SYSTEM_STACK},
+        {"systemstack_switch",     go::symbol::FUNC_ID_SYSTEM_STACK_SWITCH}
 };
 
-go::symbol::SymbolTable::SymbolTable(
-        SymbolVersion version,
-        endian::Converter converter,
-        MemoryBuffer memoryBuffer,
-        uint64_t base
-) : mVersion(version), mConverter(converter), mMemoryBuffer(std::move(memoryBuffer)), mBase(base) {
-    const std::byte *buffer = data();
-
-    mQuantum = std::to_integer<uint32_t>(buffer[6]);
-    mPtrSize = std::to_integer<uint32_t>(buffer[7]);
-
-    switch (mVersion) {
-        case VERSION12: {
-            mFuncNum = mConverter(buffer + 8, mPtrSize);
-            mFuncData = buffer;
-            mFuncNameTable = buffer;
-            mFuncTable = buffer + 8 + mPtrSize;
-            mPCTable = buffer;
-
-            uint32_t funcTableSize = mFuncNum * 2 * mPtrSize + mPtrSize;
-            uint32_t fileOffset = mConverter(*(uint32_t *) (mFuncTable + funcTableSize));
-
-            mFileTable = buffer + fileOffset;
-            mFileNum = mConverter(*(uint32_t *) mFileTable);
-
-            break;
-        }
-
-        case VERSION116: {
-            mFuncNum = mConverter(buffer + 8, mPtrSize);
-            mFileNum = mConverter(buffer + 8 + mPtrSize, mPtrSize);
-
-            mFuncNameTable = buffer + mConverter(buffer + 8 + 2 * mPtrSize, mPtrSize);
-            mCuTable = buffer + mConverter(buffer + 8 + 3 * mPtrSize, mPtrSize);
-            mFileTable = buffer + mConverter(buffer + 8 + 4 * mPtrSize, mPtrSize);
-            mPCTable = buffer + mConverter(buffer + 8 + 5 * mPtrSize, mPtrSize);
-            mFuncData = buffer + mConverter(buffer + 8 + 6 * mPtrSize, mPtrSize);
-            mFuncTable = buffer + mConverter(buffer + 8 + 6 * mPtrSize, mPtrSize);
-
-            break;
-        }
-
-        case VERSION118:
-        case VERSION120: {
-            mFuncNum = mConverter(buffer + 8, mPtrSize);
-            mFileNum = mConverter(buffer + 8 + mPtrSize, mPtrSize);
-
-            mBase += mConverter(buffer + 8 + 2 * mPtrSize, mPtrSize);
+// funcID enums of the runtime in declaration order.
+constexpr go::symbol::FuncID GO116_FUNC_IDS[] = {
+        go::symbol::FUNC_ID_NORMAL,
+        go::symbol::FUNC_ID_RUNTIME_MAIN,
+        go::symbol::FUNC_ID_GO_EXIT,
+        go::symbol::FUNC_ID_JMP_DEFER,
+        go::symbol::FUNC_ID_MCALL,
+        go::symbol::FUNC_ID_MORE_STACK,
+        go::symbol::FUNC_ID_MSTART,
+        go::symbol::FUNC_ID_RT0_GO,
+        go::symbol::FUNC_ID_ASM_CGO_CALL,
+        go::symbol::FUNC_ID_SIG_PANIC,
+        go::symbol::FUNC_ID_RUN_FINQ,
+        go::symbol::FUNC_ID_GC_BG_MARK_WORKER,
+        go::symbol::FUNC_ID_SYSTEM_STACK_SWITCH,
+        go::symbol::FUNC_ID_SYSTEM_STACK,
+        go::symbol::FUNC_ID_CGO_CALLBACK,
+        go::symbol::FUNC_ID_GO_GO,
+        go::symbol::FUNC_ID_EXTERNAL_THREAD_HANDLER,
+        go::symbol::FUNC_ID_DEBUG_CALL,
+        go::symbol::FUNC_ID_GO_PANIC,
+        go::symbol::FUNC_ID_PANIC_WRAP,
+        go::symbol::FUNC_ID_HANDLE_ASYNC_EVENT,
+        go::symbol::FUNC_ID_ASYNC_PREEMPT,
+        go::symbol::FUNC_ID_WRAPPER
+};
 
-            mFuncNameTable = buffer + mConverter(buffer + 8 + 3 * mPtrSize, mPtrSize);
-            mCuTable = buffer + mConverter(buffer + 8 + 4 * mPtrSize, mPtrSize);
-            mFileTable = buffer + mConverter(buffer + 8 + 5 * mPtrSize, mPtrSize);
-            mPCTable = buffer + mConverter(buffer + 8 + 6 * mPtrSize, mPtrSize);
-            mFuncData = buffer + mConverter(buffer + 8 + 7 * mPtrSize, mPtrSize);
-            mFuncTable = buffer + mConverter(buffer + 8 + 7 * mPtrSize, mPtrSize);
+constexpr go::symbol::FuncID GO117_FUNC_IDS[] = {
+        go::symbol::FUNC_ID_NORMAL,
+        go::symbol::FUNC_ID_ABORT,
+        go::symbol::FUNC_ID_ASM_CGO_CALL,
+        go::symbol::FUNC_ID_ASYNC_PREEMPT,
+        go::symbol::FUNC_ID_CGO_CALLBACK,
+        go::symbol::FUNC_ID_DEBUG_CALL,
+        go::symbol::FUNC_ID_GC_BG_MARK_WORKER,
+        go::symbol::FUNC_ID_GO_EXIT,
+        go::symbol::FUNC_ID_GO_GO,
+        go::symbol::FUNC_ID_GO_PANIC,
+        go::symbol::FUNC_ID_HANDLE_ASYNC_EVENT,
+        go::symbol::FUNC_ID_JMP_DEFER,
+        go::symbol::FUNC_ID_MCALL,
+        go::symbol::FUNC_ID_MORE_STACK,
+        go::symbol::FUNC_ID_MSTART,
+        go::symbol::FUNC_ID_PANIC_WRAP,
+        go::symbol::FUNC_ID_RT0_GO,
+        go::symbol::FUNC_ID_RUN_FINQ,
+        go::symbol::FUNC_ID_RUNTIME_MAIN,
+        go::symbol::FUNC_ID_SIG_PANIC,
+        go::symbol::FUNC_ID_SYSTEM_STACK,
+        go::symbol::FUNC_ID_SYSTEM_STACK_SWITCH,
+        go::symbol::FUNC_ID_WRAPPER
+};
 
-            break;
-        }
-    }
-}
+constexpr go::symbol::FuncID GO118_FUNC_IDS[] = {
+        go::symbol::FUNC_ID_NORMAL,
+        go::symbol::FUNC_ID_ABORT,
+        go::symbol::FUNC_ID_ASM_CGO_CALL,
+        go::symbol::FUNC_ID_ASYNC_PREEMPT,
+        go::symbol::FUNC_ID_CGO_CALLBACK,
+        go::symbol::FUNC_ID_DEBUG_CALL,
+        go::symbol::FUNC_ID_GC_BG_MARK_WORKER,
+        go::symbol::FUNC_ID_GO_EXIT,
+        go::symbol::FUNC_ID_GO_GO,
+        go::symbol::FUNC_ID_GO_PANIC,
+        go::symbol::FUNC_ID_HANDLE_ASYNC_EVENT,
+        go::symbol::FUNC_ID_MCALL,
+        go::symbol::FUNC_ID_MORE_STACK,
+        go::symbol::FUNC_ID_MSTART,
+        go::symbol::FUNC_ID_PANIC_WRAP,
+        go::symbol::FUNC_ID_RT0_GO,
+        go::symbol::FUNC_ID_RUN_FINQ,
+        go::symbol::FUNC_ID_RUNTIME_MAIN,
+        go::symbol::FUNC_ID_SIG_PANIC,
+        go::symbol::FUNC_ID_SYSTEM_STACK,
+        go::symbol::FUNC_ID_SYSTEM_STACK_SWITCH,
+        go::symbol::FUNC_ID_WRAPPER
+};
 
-go::symbol::SymbolIterator go::symbol::SymbolTable::find(uint64_t address) const {
-    if (address < operator[](0).entry() || address >= operator[](mFuncNum).entry())
-        return end();
+constexpr go::symbol::FuncID GO123_FUNC_IDS[] = {
+        go::symbol::FUNC_ID_NORMAL,
+        go::symbol::FUNC_ID_ABORT,
+        go::symbol::FUNC_ID_ASM_CGO_CALL,
+        go::symbol::FUNC_ID_ASYNC_PREEMPT,
+        go::symbol::FUNC_ID_CGO_CALLBACK,
+        go::symbol::FUNC_ID_CORO_START,
+        go::symbol::FUNC_ID_DEBUG_CALL,
+        go::symbol::FUNC_ID_GC_BG_MARK_WORKER,
+        go::symbol::FUNC_ID_GO_EXIT,
+        go::symbol::FUNC_ID_GO_GO,
+        go::symbol::FUNC_ID_GO_PANIC,
+        go::symbol::FUNC_ID_HANDLE_ASYNC_EVENT,
+        go::symbol::FUNC_ID_MCALL,
+        go::symbol::FUNC_ID_MORE_STACK,
+        go::symbol::FUNC_ID_MSTART,
+        go::symbol::FUNC_ID_PANIC_WRAP,
+        go::symbol::FUNC_ID_RT0_GO,
+        go::symbol::FUNC_ID_RUN_FINQ,
+        go::symbol::FUNC_ID_RUNTIME_MAIN,
+        go::symbol::FUNC_ID_SIG_PANIC,
+        go::symbol::FUNC_ID_SYSTEM_STACK,
+        go::symbol::FUNC_ID_SYSTEM_STACK_SWITCH,
+        go::symbol::FUNC_ID_WRAPPER
+};
 
-    return std::upper_bound(begin(), end() + 1, address, [](uint64_t value, const auto &entry) {
-        return value < entry.entry();
-    }) - 1;
-}
+// raw values past the end of an enum are not special.
+template<size_t N>
+static go::symbol::FuncIDMap funcIDMap(const go::symbol::FuncID (&ids)[N]) {
+    go::symbol::FuncIDMap map = {};
 
-go::symbol::SymbolIterator go::symbol::SymbolTable::find(std::string_view name) const {
-    return std::find_if(begin(), end(), [=](const auto &entry) {
-        return name == entry.symbol().name();
-    });
-}
+    map.fill(go::symbol::FUNC_ID_NORMAL);
+    std::copy(std::begin(ids), std::end(ids), map.begin());
 
-size_t go::symbol::SymbolTable::size() const {
-    return mFuncNum;
+    return map;
 }
 
-go::symbol::SymbolEntry go::symbol::SymbolTable::operator[](size_t index) const {
-    return *(begin() + std::ptrdiff_t(index));
-}
+std::optional<go::symbol::SymbolVersion> go::symbol::symbolVersion(uint32_t magic) {
+    switch (magic) {
+        case SYMBOL_MAGIC_12:
+            return VERSION12;
 
-go::symbol::SymbolIterator go::symbol::SymbolTable::begin() const {
-    return {this, mFuncTable};
-}
+        case SYMBOL_MAGIC_116:
+            return VERSION116;
 
-go::symbol::SymbolIterator go::symbol::SymbolTable::end() const {
-    return begin() + mFuncNum;
-}
+        case SYMBOL_MAGIC_118:
+            return VERSION118;
 
-const std::byte *go::symbol::SymbolTable::data() const {
-    size_t index = mMemoryBuffer.index();
+        case SYMBOL_MAGIC_120:
+            return VERSION120;
 
-    if (index == 0) {
-        return std::get<std::shared_ptr<elf::ISection>>(mMemoryBuffer)->data();
-    } else if (index == 1) {
-        return std::get<std::unique_ptr<std::byte[]>>(mMemoryBuffer).get();
+        default:
+            return std::nullopt;
     }
-
-    return std::get<const std::byte *>(mMemoryBuffer);
 }
 
-go::symbol::Symbol::Symbol(const go::symbol::SymbolTable *table, const std::byte *buffer)
-        : mTable(table), mBuffer(buffer) {
+std::optional<go::symbol::FuncID> go::symbol::detail::lookupFuncID(std::string_view name) {
+    if (name.substr(0, strlen(RUNTIME_PREFIX)) != RUNTIME_PREFIX)
+        return std::nullopt;
 
-}
-
-uint64_t go::symbol::Symbol::entry() const {
-    if (mTable->mVersion < VERSION118)
-        return mTable->mBase + mTable->mConverter(mBuffer, mTable->mPtrSize);
-
-    return mTable->mBase + mTable->mConverter(*(uint32_t *) mBuffer);
-}
-
-const char *go::symbol::Symbol::name() const {
-    return (const char *) mTable->mFuncNameTable + field(1);
-}
-
-int go::symbol::Symbol::frameSize(uint64_t pc) const {
-    uint32_t sp = field(4);
-
-    if (sp == 0)
-        return 0;
-
-    int x = value(sp, entry(), pc);
-
-    if (x == -1)
-        return 0;
-
-    if (x & (mTable->mPtrSize - 1))
-        return 0;
-
-    return x;
-}
+    name.remove_prefix(strlen(RUNTIME_PREFIX));
 
-int go::symbol::Symbol::sourceLine(uint64_t pc) const {
-    return value(field(6), entry(), pc);
-}
-
-const char *go::symbol::Symbol::sourceFile(uint64_t pc) const {
-    int n = value(field(5), entry(), pc);
-
-    if (n < 0 || n > mTable->mFileNum)
-        return "";
-
-    if (mTable->mVersion == VERSION12) {
-        if (n == 0)
-            return "";
-
-        return (const char *) mTable->mFuncData + mTable->mConverter((mTable->mFileTable + n * 4), sizeof(int));
-    }
-
-    uint32_t offset = mTable->mConverter((mTable->mCuTable + (field(8) + n) * 4), sizeof(uint32_t));
-
-    if (!offset)
-        return "";
-
-    return (const char *) mTable->mFileTable + offset;
-}
-
-bool go::symbol::Symbol::isStackTop() const {
-    return std::any_of(STACK_TOP_FUNCTION.begin(), STACK_TOP_FUNCTION.end(), [name = name()](const auto &func) {
-        return strcmp(func, name) == 0;
+    auto it = std::find_if(std::begin(RUNTIME_FUNC_IDS), std::end(RUNTIME_FUNC_IDS), [=](const auto &pair) {
+        return pair.first == name;
     });
-}
 
-uint32_t go::symbol::Symbol::field(int n) const {
-    return mTable->mConverter(
-            *(uint32_t *) (mBuffer + (mTable->mVersion >= VERSION118 ? 4 : mTable->mPtrSize) + (n - 1) * 4)
-    );
-}
-
-int go::symbol::Symbol::value(uint32_t offset, uint64_t entry, uint64_t target) const {
-    const std::byte *buffer = mTable->mPCTable + offset;
-
-    int value = -1;
-    uint64_t pc = entry;
-
-    while (true) {
-        std::optional<std::pair<int64_t, int>> result = binary::varInt(buffer);
-
-        if (!result)
-            return -1;
-
-        if (result->first == 0 && pc != entry)
-            return -1;
-
-        value += int(result->first);
-        buffer += result->second;
-
-        result = binary::uVarInt(buffer);
-
-        if (!result)
-            return -1;
-
-        pc += result->first * mTable->mQuantum;
-        buffer += result->second;
-
-        if (target < pc)
-            break;
-    }
-
-    return value;
-}
-
-go::symbol::SymbolEntry::SymbolEntry(const go::symbol::SymbolTable *table, uint64_t entry, uint64_t offset)
-        : mTable(table), mEntry(entry), mOffset(offset) {
-
-}
-
-uint64_t go::symbol::SymbolEntry::entry() const {
-    return mEntry;
-}
-
-go::symbol::Symbol go::symbol::SymbolEntry::symbol() const {
-    return {mTable, mTable->mFuncData + mOffset};
-}
-
-go::symbol::SymbolIterator::SymbolIterator(const go::symbol::SymbolTable *table, const std::byte *buffer)
-        : mTable(table), mBuffer(buffer), mSize(table->mVersion >= VERSION118 ? 4 : table->mPtrSize) {
-
-}
-
-go::symbol::SymbolEntry go::symbol::SymbolIterator::operator*() {
-    return {
-            mTable,
-            mTable->mBase + mTable->mConverter(mBuffer, mSize),
-            mTable->mConverter(mBuffer + mSize, mSize)
-    };
-}
-
-go::symbol::SymbolIterator &go::symbol::SymbolIterator::operator--() {
-    mBuffer -= 2 * mSize;
-    return *this;
-}
-
-go::symbol::SymbolIterator &go::symbol::SymbolIterator::operator++() {
-    mBuffer += 2 * mSize;
-    return *this;
-}
-
-go::symbol::SymbolIterator &go::symbol::SymbolIterator::operator+=(std::ptrdiff_t offset) {
-    mBuffer += offset * 2 * mSize;
-    return *this;
-}
-
-go::symbol::SymbolIterator go::symbol::SymbolIterator::operator-(std::ptrdiff_t offset) {
-    return {mTable, mBuffer - offset * 2 * mSize};
-}
-
-go::symbol::SymbolIterator go::symbol::SymbolIterator::operator+(std::ptrdiff_t offset) {
-    return {mTable, mBuffer + offset * 2 * mSize};
-}
-
-bool go::symbol::SymbolIterator::operator==(const go::symbol::SymbolIterator &rhs) {
-    return mBuffer == rhs.mBuffer;
-}
+    if (it == std::end(RUNTIME_FUNC_IDS))
+        return std::nullopt;
 
-bool go::symbol::SymbolIterator::operator!=(const go::symbol::SymbolIterator &rhs) {
-    return !operator==(rhs);
+    return it->second;
 }
 
-std::ptrdiff_t go::symbol::SymbolIterator::operator-(const go::symbol::SymbolIterator &rhs) {
-    return (mBuffer - rhs.mBuffer) / std::ptrdiff_t(2 * mSize);
-}
-
-go::symbol::seek::SymbolTable::SymbolTable(
-        SymbolVersion version,
-        endian::Converter converter,
-        std::ifstream stream,
-        std::streamoff offset,
-        uint64_t address,
-        uint64_t base
-) : mVersion(version), mConverter(converter), mStream(std::move(stream)), mOffset(offset), mAddress(address),
-    mBase(base) {
-    std::byte buffer[128];
-
-    mStream.seekg(mOffset, std::ifstream::beg);
-    mStream.read((char *) buffer, sizeof(buffer));
-
-    mQuantum = std::to_integer<uint32_t>(buffer[6]);
-    mPtrSize = std::to_integer<uint32_t>(buffer[7]);
-
-    switch (mVersion) {
-        case VERSION12: {
-            mFuncNum = mConverter(buffer + 8, mPtrSize);
-            mFuncData = mAddress;
-            mFuncNameTable = mAddress;
-            mFuncTable = mAddress + 8 + mPtrSize;
-            mPCTable = mAddress;
-
-            uint32_t funcTableSize = mFuncNum * 2 * mPtrSize + mPtrSize;
-            uint32_t fileOffset = 0;
-
-            mStream.seekg(mOffset + (std::streamoff) (mFuncTable + funcTableSize - mAddress), std::ifstream::beg);
-            mStream.read((char *) &fileOffset, sizeof(uint32_t));
-            fileOffset = mConverter(fileOffset);
-
-            mFileTable = mAddress + fileOffset;
-
-            mStream.seekg(mOffset + (std::streamoff) (mFileTable - mAddress), std::ifstream::beg);
-            mStream.read((char *) &mFileNum, sizeof(uint32_t));
-
-            mFileNum = mConverter(mFileNum);
-
-            break;
-        }
-
-        case VERSION116: {
-            mFuncNum = mConverter(buffer + 8, mPtrSize);
-            mFileNum = mConverter(buffer + 8 + mPtrSize, mPtrSize);
+// releases sharing a magic, newest first. go 1.17 sorted the enum, 1.18 dropped jmpdefer and 1.23 added corostart.
+std::vector<const go::symbol::FuncIDMap *> go::symbol::detail::funcIDMaps(SymbolVersion version) {
+    static const FuncIDMap go116 = funcIDMap(GO116_FUNC_IDS);
+    static const FuncIDMap go117 = funcIDMap(GO117_FUNC_IDS);
+    static const FuncIDMap go118 = funcIDMap(GO118_FUNC_IDS);
+    static const FuncIDMap go123 = funcIDMap(GO123_FUNC_IDS);
 
-            mFuncNameTable = mAddress + mConverter(buffer + 8 + 2 * mPtrSize, mPtrSize);
-            mCuTable = mAddress + mConverter(buffer + 8 + 3 * mPtrSize, mPtrSize);
-            mFileTable = mAddress + mConverter(buffer + 8 + 4 * mPtrSize, mPtrSize);
-            mPCTable = mAddress + mConverter(buffer + 8 + 5 * mPtrSize, mPtrSize);
-            mFuncData = mAddress + mConverter(buffer + 8 + 6 * mPtrSize, mPtrSize);
-            mFuncTable = mAddress + mConverter(buffer + 8 + 6 * mPtrSize, mPtrSize);
-
-            break;
-        }
+    switch (version) {
+        case VERSION116:
+            return {&go117, &go116};
 
         case VERSION118:
-        case VERSION120: {
-            mFuncNum = mConverter(buffer + 8, mPtrSize);
-            mFileNum = mConverter(buffer + 8 + mPtrSize, mPtrSize);
-
-            mBase += mConverter(buffer + 8 + 2 * mPtrSize, mPtrSize);
-
-            mFuncNameTable = mAddress + mConverter(buffer + 8 + 3 * mPtrSize, mPtrSize);
-            mCuTable = mAddress + mConverter(buffer + 8 + 4 * mPtrSize, mPtrSize);
-            mFileTable = mAddress + mConverter(buffer + 8 + 5 * mPtrSize, mPtrSize);
-            mPCTable = mAddress + mConverter(buffer + 8 + 6 * mPtrSize, mPtrSize);
-            mFuncData = mAddress + mConverter(buffer + 8 + 7 * mPtrSize, mPtrSize);
-            mFuncTable = mAddress + mConverter(buffer + 8 + 7 * mPtrSize, mPtrSize);
-
-            break;
-        }
-    }
-
-    uint64_t size = (mFuncNum + 1) * 2 * (mVersion >= VERSION118 ? 4 : mPtrSize);
-    mFuncTableBuffer = std::make_unique<std::byte[]>(size);
-
-    mStream.seekg(mOffset + (std::streamoff) (mFuncTable - mAddress), std::ifstream::beg);
-    mStream.read((char *) mFuncTableBuffer.get(), (std::streamsize) size);
-}
-
-go::symbol::seek::SymbolIterator go::symbol::seek::SymbolTable::find(uint64_t address) {
-    if (address < operator[](0).entry() || address >= operator[](mFuncNum).entry())
-        return end();
-
-    return std::upper_bound(begin(), end() + 1, address, [](uint64_t value, const auto &entry) {
-        return value < entry.entry();
-    }) - 1;
-}
-
-go::symbol::seek::SymbolIterator go::symbol::seek::SymbolTable::find(std::string_view name) {
-    return std::find_if(begin(), end(), [=](const auto &entry) {
-        return name == entry.symbol().name();
-    });
-}
-
-size_t go::symbol::seek::SymbolTable::size() const {
-    return mFuncNum;
-}
-
-go::symbol::seek::SymbolEntry go::symbol::seek::SymbolTable::operator[](size_t index) {
-    return *(begin() + std::ptrdiff_t(index));
-}
-
-go::symbol::seek::SymbolIterator go::symbol::seek::SymbolTable::begin() {
-    return {this, mFuncTableBuffer.get()};
-}
-
-go::symbol::seek::SymbolIterator go::symbol::seek::SymbolTable::end() {
-    return begin() + mFuncNum;
-}
-
-go::symbol::seek::Symbol::Symbol(go::symbol::seek::SymbolTable *table, uint64_t address)
-        : mTable(table), mAddress(address) {
-
-}
+            return {&go118, &go117};
 
-uint64_t go::symbol::seek::Symbol::entry() const {
-    if (mTable->mVersion < VERSION118) {
-        std::byte buffer[8] = {};
+        case VERSION120:
+            return {&go123, &go118};
 
-        mTable->mStream.seekg(mTable->mOffset + (std::streamoff) (mAddress - mTable->mAddress), std::ifstream::beg);
-        mTable->mStream.read((char *) &buffer, mTable->mPtrSize);
-
-        if (mTable->mPtrSize == 4)
-            return mTable->mBase + mTable->mConverter(*(uint32_t *) buffer);
-
-        return mTable->mBase + mTable->mConverter(*(uint64_t *) buffer);
+        default:
+            return {&go118};
     }
-
-    uint32_t entry;
-
-    mTable->mStream.seekg(mTable->mOffset + (std::streamoff) (mAddress - mTable->mAddress), std::ifstream::beg);
-    mTable->mStream.read((char *) &entry, sizeof(uint32_t));
-
-    return mTable->mBase + mTable->mConverter(entry);
 }
 
-std::string go::symbol::seek::Symbol::name() const {
-    mTable->mStream.seekg(
-            mTable->mOffset + (std::streamoff) (mTable->mFuncNameTable + field(1) - mTable->mAddress),
-            std::ifstream::beg
-    );
-
-    std::string name;
-    std::getline(mTable->mStream, name, '\0');
-
-    return name;
-}
-
-int go::symbol::seek::Symbol::frameSize(uint64_t pc) const {
-    uint32_t sp = field(4);
-
-    if (sp == 0)
-        return 0;
-
-    int x = value(sp, entry(), pc);
-
-    if (x == -1)
-        return 0;
-
-    if (x & (mTable->mPtrSize - 1))
-        return 0;
-
-    return x;
-}
-
-int go::symbol::seek::Symbol::sourceLine(uint64_t pc) const {
-    return value(field(6), entry(), pc);
-}
-
-std::string go::symbol::seek::Symbol::sourceFile(uint64_t pc) const {
-    int n = value(field(5), entry(), pc);
-
-    if (n < 0 || n > mTable->mFileNum)
-        return "";
-
-    if (mTable->mVersion == VERSION12) {
-        if (n == 0)
-            return "";
-
-        int offset;
-
-        mTable->mStream.seekg(
-                mTable->mOffset + (std::streamoff) (mTable->mFileTable + n * 4 - mTable->mAddress),
-                std::ifstream::beg
-        );
-
-        mTable->mStream.read((char *) &offset, sizeof(int));
-        offset = mTable->mConverter(offset);
-
-        mTable->mStream.seekg(
-                mTable->mOffset + (std::streamoff) (mTable->mFuncData + offset - mTable->mAddress),
-                std::ifstream::beg
-        );
-
-        std::string name;
-        std::getline(mTable->mStream, name, '\0');
-
-        return name;
+bool go::symbol::detail::isStackTopFuncID(FuncID id) {
+    switch (id) {
+        case FUNC_ID_MSTART:
+        case FUNC_ID_RT0_GO:
+        case FUNC_ID_MCALL:
+        case FUNC_ID_MORE_STACK:
+        case FUNC_ID_LESS_STACK:
+        case FUNC_ID_ASM_CGO_CALL:
+        case FUNC_ID_EXTERNAL_THREAD_HANDLER:
+        case FUNC_ID_GO_EXIT:
+            return true;
+
+        default:
+            return false;
     }
-
-    uint32_t offset;
-
-    mTable->mStream.seekg(
-            mTable->mOffset + (std::streamoff) (mTable->mCuTable + (field(8) + n) * 4 - mTable->mAddress),
-            std::ifstream::beg
-    );
-
-    mTable->mStream.read((char *) &offset, sizeof(uint32_t));
-    offset = mTable->mConverter(offset);
-
-    if (!offset)
-        return "";
-
-    mTable->mStream.seekg(
-            mTable->mOffset + (std::streamoff) (mTable->mFileTable + offset - mTable->mAddress),
-            std::ifstream::beg
-    );
-
-    std::string name;
-    std::getline(mTable->mStream, name, '\0');
-
-    return name;
-}
-
-bool go::symbol::seek::Symbol::isStackTop() const {
-    return std::any_of(STACK_TOP_FUNCTION.begin(), STACK_TOP_FUNCTION.end(), [name = name()](const auto &func) {
-        return name == func;
-    });
 }
 
-uint32_t go::symbol::seek::Symbol::field(int n) const {
-    mTable->mStream.seekg(
-            mTable->mOffset +
-            (std::streamoff) (mAddress + (mTable->mVersion >= VERSION118 ? 4 : mTable->mPtrSize) + (n - 1) * 4 -
-                              mTable->mAddress),
-            std::ifstream::beg
-    );
+static void adviseRange(const std::byte *begin, const std::byte *end, int advice) {
+    auto pageSize = (uintptr_t) sysconf(_SC_PAGESIZE);
+    auto start = (uintptr_t) begin & ~(pageSize - 1);
 
-    uint32_t value;
-    mTable->mStream.read((char *) &value, sizeof(uint32_t));
+    if ((uintptr_t) end <= start)
+        return;
 
-    return mTable->mConverter(value);
+    if (madvise((void *) start, (uintptr_t) end - start, advice) < 0)
+        LOG_WARNING("madvise %d failed: %s", advice, strerror(errno));
 }
 
-int go::symbol::seek::Symbol::value(uint32_t offset, uint64_t entry, uint64_t target) const {
-    mTable->mStream.seekg(
-            mTable->mOffset + (std::streamoff) (mTable->mPCTable + offset - mTable->mAddress),
-            std::ifstream::beg
-    );
-
-    int length = 0;
-    std::byte buffer[1024];
-
-    mTable->mStream.read((char *) buffer, sizeof(buffer));
+void go::symbol::detail::willNeed(const std::byte *begin, const std::byte *end, bool populate) {
+#ifdef MADV_POPULATE_READ
+    if (populate) {
+        auto pageSize = (uintptr_t) sysconf(_SC_PAGESIZE);
+        auto start = (uintptr_t) begin & ~(pageSize - 1);
 
-    int value = -1;
-    uint64_t pc = entry;
-
-    while (true) {
-        std::optional<std::pair<int64_t, int>> result = binary::varInt(buffer + length);
-
-        if (!result)
-            return -1;
-
-        if (result->first == 0 && pc != entry)
-            return -1;
-
-        value += int(result->first);
-        length += result->second;
-
-        result = binary::uVarInt(buffer + length);
-
-        if (!result)
-            return -1;
-
-        pc += result->first * mTable->mQuantum;
-        length += result->second;
-
-        if (target < pc)
-            break;
-
-        if (sizeof(buffer) - length >= 2 * MAX_VAR_INT_LENGTH)
-            continue;
-
-        memcpy(buffer, buffer + length, sizeof(buffer) - length);
-        mTable->mStream.read((char *) buffer + sizeof(buffer) - length, length);
-
-        length = 0;
+        if ((uintptr_t) end > start && madvise((void *) start, (uintptr_t) end - start, MADV_POPULATE_READ) == 0)
+            return;
     }
-
-    return value;
+#endif
+    adviseRange(begin, end, MADV_WILLNEED);
 }
 
-go::symbol::seek::SymbolEntry::SymbolEntry(go::symbol::seek::SymbolTable *table, uint64_t entry, uint64_t offset)
-        : mTable(table), mEntry(entry), mOffset(offset) {
-
-}
-
-uint64_t go::symbol::seek::SymbolEntry::entry() const {
-    return mEntry;
+void go::symbol::detail::randomAccess(const std::byte *begin, const std::byte *end) {
+    adviseRange(begin, end, MADV_RANDOM);
 }
-
-go::symbol::seek::Symbol go::symbol::seek::SymbolEntry::symbol() const {
-    return {mTable, mTable->mFuncData + mOffset};
-}
-
-go::symbol::seek::SymbolIterator::SymbolIterator(go::symbol::seek::SymbolTable *table, const std::byte *buffer)
-        : mTable(table), mBuffer(buffer), mSize(table->mVersion >= VERSION118 ? 4 : table->mPtrSize) {
-
-}
-
-go::symbol::seek::SymbolEntry go::symbol::seek::SymbolIterator::operator*() {
-    return {
-            mTable,
-            mTable->mBase + mTable->mConverter(mBuffer, mSize),
-            mTable->mConverter(mBuffer + mSize, mSize)
-    };
-}
-
-go::symbol::seek::SymbolIterator &go::symbol::seek::SymbolIterator::operator--() {
-    mBuffer -= 2 * mSize;
-    return *this;
-}
-
-go::symbol::seek::SymbolIterator &go::symbol::seek::SymbolIterator::operator++() {
-    mBuffer += 2 * mSize;
-    return *this;
-}
-
-go::symbol::seek::SymbolIterator &go::symbol::seek::SymbolIterator::operator+=(std::ptrdiff_t offset) {
-    mBuffer += offset * 2 * mSize;
-    return *this;
-}
-
-go::symbol::seek::SymbolIterator go::symbol::seek::SymbolIterator::operator-(std::ptrdiff_t offset) {
-    return {mTable, mBuffer - offset * 2 * mSize};
-}
-
-go::symbol::seek::SymbolIterator go::symbol::seek::SymbolIterator::operator+(std::ptrdiff_t offset) {
-    return {mTable, mBuffer + offset * 2 * mSize};
-}
-
-bool go::symbol::seek::SymbolIterator::operator==(const go::symbol::seek::SymbolIterator &rhs) {
-    return mBuffer == rhs.mBuffer;
-}
-
-bool go::symbol::seek::SymbolIterator::operator!=(const go::symbol::seek::SymbolIterator &rhs) {
-    return !operator==(rhs);
-}
-
-std::ptrdiff_t go::symbol::seek::SymbolIterator::operator-(const go::symbol::seek::SymbolIterator &rhs) {
-    return (mBuffer - rhs.mBuffer) / std::ptrdiff_t(2 * mSize);
-}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include <go/symbol/symbolizer.h>
+#include <zero/log.h>
+#include <algorithm>
+
+template<typename Table>
+std::vector<go::symbol::Frame> go::symbol::symbolize(Table &table, const std::vector<uint64_t> &pcs) {
+    std::vector<uint64_t> addresses = pcs;
+
+    std::sort(addresses.begin(), addresses.end());
+    addresses.erase(std::unique(addresses.begin(), addresses.end()), addresses.end());
+
+    std::vector<Frame> frames;
+    frames.reserve(addresses.size());
+
+    if (table.size() == 0) {
+        for (const auto &pc: addresses)
+            frames.push_back({pc, 0, {}, {}, -1});
+    } else {
+        uint64_t lowest = table[0].entry();
+        uint64_t highest = table[table.size()].entry();
+
+        auto cursor = table.begin();
+
+        // lookups run in ascending order, so each search starts from the previous hit.
+        for (const auto &pc: addresses) {
+            if (pc < lowest || pc >= highest) {
+                frames.push_back({pc, 0, {}, {}, -1});
+                continue;
+            }
+
+            cursor = std::upper_bound(cursor, table.end() + 1, pc, [](uint64_t value, const auto &entry) {
+                return value < entry.entry();
+            }) - 1;
+
+            auto entry = *cursor;
+            auto symbol = entry.symbol();
+
+            if (!frames.empty() && frames.back().entry == entry.entry()) {
+                frames.push_back({pc, entry.entry(), frames.back().name, symbol.sourceFile(pc), symbol.sourceLine(pc)});
+                continue;
+            }
+
+            frames.push_back({pc, entry.entry(), symbol.name(), symbol.sourceFile(pc), symbol.sourceLine(pc)});
+        }
+    }
+
+    std::vector<Frame> result;
+    result.reserve(pcs.size());
+
+    for (const auto &pc: pcs)
+        result.push_back(frames[std::lower_bound(addresses.begin(), addresses.end(), pc) - addresses.begin()]);
+
+    return result;
+}
+
+template std::vector<go::symbol::Frame>
+go::symbol::symbolize(const go::symbol::SymbolTable &table, const std::vector<uint64_t> &pcs);
+
+template std::vector<go::symbol::Frame>
+go::symbol::symbolize(go::symbol::seek::SymbolTable &table, const std::vector<uint64_t> &pcs);
+
+go::symbol::Symbolizer::Symbolizer(std::shared_ptr<const SymbolTable> table, size_t workers, size_t capacity)
+        : mCapacity(std::max<size_t>(capacity, 1)), mTable(std::move(table)) {
+    // without a table no worker starts, and submissions fail like they do on a stopped symbolizer.
+    if (!mTable) {
+        LOG_ERROR("symbolizer requires a symbol table");
+        return;
+    }
+
+    for (size_t i = 0; i < std::max<size_t>(workers, 1); i++)
+        mWorkers.emplace_back([this] { run(*mTable); });
+}
+
+go::symbol::Symbolizer::Symbolizer(
+        const std::function<std::optional<seek::SymbolTable>()> &factory,
+        size_t workers,
+        size_t capacity
+) : mCapacity(std::max<size_t>(capacity, 1)) {
+    // seek tables share a stream cursor, so every worker owns a private one.
+    for (size_t i = 0; i < std::max<size_t>(workers, 1); i++) {
+        std::optional<seek::SymbolTable> table = factory();
+
+        if (!table) {
+            LOG_ERROR("create symbol table for worker %zu failed", i);
+            continue;
+        }
+
+        mSeekTables.push_back(std::move(*table));
+    }
+
+    for (auto &table: mSeekTables)
+        mWorkers.emplace_back([this, &table] { run(table); });
+}
+
+go::symbol::Symbolizer::~Symbolizer() {
+    stop();
+}
+
+std::future<std::vector<go::symbol::Frame>> go::symbol::Symbolizer::submit(std::vector<uint64_t> pcs) {
+    Task task = {std::move(pcs)};
+    std::future<std::vector<Frame>> future = task.promise.get_future();
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mNotFull.wait(lock, [this] { return mStopped || mQueue.size() < mCapacity; });
+
+    if (mStopped || mWorkers.empty()) {
+        lock.unlock();
+        task.promise.set_exception(std::make_exception_ptr(std::runtime_error("symbolizer stopped")));
+        return future;
+    }
+
+    mQueue.push_back(std::move(task));
+    lock.unlock();
+
+    mNotEmpty.notify_one();
+    return future;
+}
+
+std::optional<std::future<std::vector<go::symbol::Frame>>> go::symbol::Symbolizer::trySubmit(std::vector<uint64_t> pcs) {
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    if (mStopped || mWorkers.empty() || mQueue.size() >= mCapacity)
+        return std::nullopt;
+
+    Task task = {std::move(pcs)};
+    std::future<std::vector<Frame>> future = task.promise.get_future();
+
+    mQueue.push_back(std::move(task));
+    lock.unlock();
+
+    mNotEmpty.notify_one();
+    return future;
+}
+
+void go::symbol::Symbolizer::stop() {
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+
+        if (mStopped)
+            return;
+
+        mStopped = true;
+    }
+
+    mNotEmpty.notify_all();
+    mNotFull.notify_all();
+
+    for (auto &worker: mWorkers)
+        worker.join();
+}
+
+std::optional<go::symbol::Symbolizer::Task> go::symbol::Symbolizer::pop() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mNotEmpty.wait(lock, [this] { return mStopped || !mQueue.empty(); });
+
+    // pending batches are drained before the workers exit.
+    if (mQueue.empty())
+        return std::nullopt;
+
+    Task task = std::move(mQueue.front());
+    mQueue.pop_front();
+    lock.unlock();
+
+    mNotFull.notify_one();
+    return task;
+}
+
+template<typename Table>
+void go::symbol::Symbolizer::run(Table &table) {
+    while (true) {
+        std::optional<Task> task = pop();
+
+        if (!task)
+            break;
+
+        // a failed batch is reported through its future rather than taking the worker down.
+        try {
+            task->promise.set_value(symbolize(table, task->pcs));
+        } catch (...) {
+            task->promise.set_exception(std::current_exception());
+        }
+    }
+}
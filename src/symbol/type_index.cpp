@@ -0,0 +1,94 @@
+#include <go/symbol/type_index.h>
+
+constexpr auto KIND_POINTER = 22;
+constexpr auto KIND_STRUCT = 25;
+
+// type strings qualify names by package name, and most structs are only reachable through a pointer type,
+// so both sides are reduced to the name without leading stars and import path.
+static std::string_view normalize(std::string_view name) {
+    size_t stars = name.find_first_not_of('*');
+
+    if (stars == std::string_view::npos)
+        return {};
+
+    name.remove_prefix(stars);
+
+    size_t slash = name.substr(0, name.find('[')).rfind('/');
+
+    if (slash != std::string_view::npos)
+        name.remove_prefix(slash + 1);
+
+    return name;
+}
+
+// a type whose fields cannot all be read is left out, as if the binary did not have it.
+static std::optional<std::vector<go::symbol::FieldOffset>> decode(const go::symbol::Struct &type) {
+    size_t count = type.fieldCount();
+
+    std::vector<go::symbol::FieldOffset> fields;
+    fields.reserve(count);
+
+    for (size_t i = 0; i < count; i++) {
+        std::optional<std::pair<std::string, uint64_t>> field = type.field(i);
+
+        if (!field)
+            return std::nullopt;
+
+        fields.push_back({std::move(field->first), field->second});
+    }
+
+    return fields;
+}
+
+go::symbol::TypeIndex::TypeIndex(const StructTable &table) {
+    // a struct type beats pointers to it, and a pointer with fewer stars beats a deeper one.
+    std::unordered_map<std::string, std::pair<size_t, size_t>> ranks;
+
+    for (size_t i = 0; i < table.size(); i++) {
+        Struct type = table[i];
+        std::optional<int> kind = type.kind();
+
+        if (!kind || (*kind != KIND_STRUCT && *kind != KIND_POINTER))
+            continue;
+
+        std::optional<std::string> name = type.name();
+
+        if (!name)
+            continue;
+
+        std::string key(normalize(*name));
+
+        if (key.empty() || (*kind == KIND_POINTER && type.fieldCount() == 0))
+            continue;
+
+        size_t rank = *kind == KIND_STRUCT ? 0 : name->find_first_not_of('*') + 1;
+        auto it = ranks.find(key);
+
+        if (it != ranks.end() && it->second.first <= rank)
+            continue;
+
+        ranks[key] = {rank, i};
+    }
+
+    for (const auto &[key, rank]: ranks) {
+        std::optional<std::vector<FieldOffset>> fields = decode(table[rank.second]);
+
+        if (!fields)
+            continue;
+
+        mFields.emplace(key, std::move(*fields));
+    }
+}
+
+size_t go::symbol::TypeIndex::size() const {
+    return mFields.size();
+}
+
+std::optional<std::vector<go::symbol::FieldOffset>> go::symbol::TypeIndex::fields(const std::string &name) const {
+    auto it = mFields.find(std::string(normalize(name)));
+
+    if (it == mFields.end())
+        return std::nullopt;
+
+    return it->second;
+}